@@ -1,22 +1,68 @@
 #include "graph.hpp"
+#include "triconnectivity.hpp"
 #include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
 
 using namespace std;
 
 // Construtor
-Graph::Graph(int vertices, int edges) : n(vertices), m(edges) {
-    adj.resize(n);
+Graph::Graph(int vertices, int edges)
+    : n(vertices), m(edges), frozen(false), cutPairContext(vertices) {
+    offsets.assign(n + 1, 0);
+    pending.reserve(edges);
+    stackVertex.resize(n);
+    stackIndex.resize(n);
 }
 
 // Adiciona uma aresta ao grafo
 void Graph::addEdge(int u, int v) {
-    adj[u].push_back(v);
-    adj[v].push_back(u);
+    pending.push_back({u, v});
+    frozen = false;
+}
+
+// Incorpora as arestas pendentes ao CSR em duas passagens de contagem,
+// mantendo a ordem de inserção dos vizinhos de cada vértice
+void Graph::freeze() {
+    if (frozen) return;
+    
+    // Primeira passagem: grau de cada vértice
+    vector<int> newOffsets(n + 1, 0);
+    for (int u = 0; u < n; u++) {
+        newOffsets[u + 1] = offsets[u + 1] - offsets[u];
+    }
+    for (const auto& e : pending) {
+        newOffsets[e.first + 1]++;
+        newOffsets[e.second + 1]++;
+    }
+    for (int u = 0; u < n; u++) {
+        newOffsets[u + 1] += newOffsets[u];
+    }
+    
+    // Segunda passagem: distribui os vizinhos (antigos primeiro, depois os novos)
+    vector<int> newTargets(newOffsets[n]);
+    vector<int> pos(newOffsets.begin(), newOffsets.end() - 1);
+    for (int u = 0; u < n; u++) {
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            newTargets[pos[u]++] = targets[i];
+        }
+    }
+    for (const auto& e : pending) {
+        newTargets[pos[e.first]++] = e.second;
+        newTargets[pos[e.second]++] = e.first;
+    }
+    
+    offsets.swap(newOffsets);
+    targets.swap(newTargets);
+    vector<pair<int, int>>().swap(pending);
+    frozen = true;
 }
 
 // Verifica se o grafo é conexo usando DFS
 bool Graph::isConnected() {
     if (n == 0) return true;
+    freeze();
     
     vector<bool> visited(n, false);
     dfs(0, visited);
@@ -28,18 +74,33 @@ bool Graph::isConnected() {
     return true;
 }
 
-// Função auxiliar para DFS
+// Função auxiliar para DFS (pilha explícita, mesma ordem de descoberta da recursão)
 void Graph::dfs(int v, vector<bool>& visited) {
+    int top = 0;
+    stackVertex[0] = v;
+    stackIndex[0] = offsets[v];
     visited[v] = true;
-    for (int u : adj[v]) {
-        if (!visited[u]) {
-            dfs(u, visited);
+    
+    while (top >= 0) {
+        int x = stackVertex[top];
+        
+        if (stackIndex[top] < offsets[x + 1]) {
+            int u = targets[stackIndex[top]++];
+            if (!visited[u]) {
+                visited[u] = true;
+                top++;
+                stackVertex[top] = u;
+                stackIndex[top] = offsets[u];
+            }
+        } else {
+            top--;
         }
     }
 }
 
 // Algoritmo de Tarjan para encontrar pontos de articulação
 vector<int> Graph::findArticulationPoints() {
+    freeze();
     vector<int> disc(n, -1);   // Tempo de descoberta
     vector<int> low(n, -1);    // Valor low para o algoritmo de Tarjan
     vector<bool> ap(n, false); // Marca se um vértice é ponto de articulação
@@ -64,146 +125,413 @@ vector<int> Graph::findArticulationPoints() {
 }
 
 // DFS para encontrar pontos de articulação (parte do algoritmo de Tarjan)
+// Iterativa: o pai de cada quadro é o vértice do quadro abaixo dele na pilha
 void Graph::dfsAP(int u, int parent, vector<int>& disc, vector<int>& low, vector<bool>& ap, int& time) {
-    int children = 0;
+    int rootChildren = 0;
+    int top = 0;
+    stackVertex[0] = u;
+    stackIndex[0] = offsets[u];
     disc[u] = low[u] = ++time;
     
-    for (int v : adj[u]) {
-        // Se v não foi visitado
-        if (disc[v] == -1) {
-            children++;
-            dfsAP(v, u, disc, low, ap, time);
+    while (top >= 0) {
+        int x = stackVertex[top];
+        int xParent = (top > 0) ? stackVertex[top - 1] : parent;
+        
+        if (stackIndex[top] < offsets[x + 1]) {
+            int v = targets[stackIndex[top]++];
             
-            // Atualiza o valor low de u
-            low[u] = min(low[u], low[v]);
+            // Se v não foi visitado, desce na árvore
+            if (disc[v] == -1) {
+                if (top == 0) rootChildren++;
+                disc[v] = low[v] = ++time;
+                top++;
+                stackVertex[top] = v;
+                stackIndex[top] = offsets[v];
+            }
+            // Se v já foi visitado e não é o pai, atualiza low[x]
+            else if (v != xParent) {
+                low[x] = min(low[x], disc[v]);
+            }
+        } else {
+            // Retorno de x para o pai: atualiza o valor low do pai
+            top--;
+            if (top < 0) break;
+            
+            int p = stackVertex[top];
+            int pParent = (top > 0) ? stackVertex[top - 1] : parent;
+            low[p] = min(low[p], low[x]);
             
             // Verifica condição para ponto de articulação
-            // Se u não é raiz e low[v] >= disc[u]
-            if (parent != -1 && low[v] >= disc[u]) {
-                ap[u] = true;
+            // Se p não é raiz e low[x] >= disc[p]
+            if (pParent != -1 && low[x] >= disc[p]) {
+                ap[p] = true;
             }
-        } 
-        // Se v já foi visitado e não é o pai, atualiza low[u]
-        else if (v != parent) {
-            low[u] = min(low[u], disc[v]);
         }
     }
     
     // Caso especial: se u é raiz e tem mais de um filho
-    if (parent == -1 && children > 1) {
+    if (parent == -1 && rootChildren > 1) {
         ap[u] = true;
     }
 }
 
+// Decompõe o grafo em blocos numa única DFS (pilha de arestas de Tarjan-Hopcroft)
+BlockCutTree Graph::findBlockCutTree() {
+    freeze();
+    
+    BlockCutTree bct;
+    vector<int> disc(n, -1);
+    vector<int> low(n, -1);
+    vector<int> stamp(n, -1); // Último bloco em que cada vértice foi incluído
+    vector<pair<int, int>> edgeStack;
+    int time = 0;
+    
+    for (int r = 0; r < n; r++) {
+        if (disc[r] != -1) continue;
+        
+        int rootChildren = 0;
+        int top = 0;
+        stackVertex[0] = r;
+        stackIndex[0] = offsets[r];
+        disc[r] = low[r] = ++time;
+        
+        while (top >= 0) {
+            int x = stackVertex[top];
+            int xParent = (top > 0) ? stackVertex[top - 1] : -1;
+            
+            if (stackIndex[top] < offsets[x + 1]) {
+                int v = targets[stackIndex[top]++];
+                
+                if (disc[v] == -1) {
+                    if (top == 0) rootChildren++;
+                    edgeStack.push_back({x, v});
+                    disc[v] = low[v] = ++time;
+                    top++;
+                    stackVertex[top] = v;
+                    stackIndex[top] = offsets[v];
+                } else if (v != xParent && disc[v] < disc[x]) {
+                    // Aresta de retorno para um ancestral
+                    edgeStack.push_back({x, v});
+                    low[x] = min(low[x], disc[v]);
+                }
+            } else {
+                top--;
+                if (top < 0) break;
+                
+                int p = stackVertex[top];
+                low[p] = min(low[p], low[x]);
+                
+                // p separa x do restante: as arestas empilhadas desde (p, x) formam um bloco
+                if (low[x] >= disc[p]) {
+                    int b = bct.blocks.size();
+                    bct.blocks.emplace_back();
+                    bct.blockEdges.emplace_back();
+                    
+                    while (true) {
+                        pair<int, int> e = edgeStack.back();
+                        edgeStack.pop_back();
+                        bct.blockEdges[b].push_back(e);
+                        
+                        if (stamp[e.first] != b) {
+                            stamp[e.first] = b;
+                            bct.blocks[b].push_back(e.first);
+                        }
+                        if (stamp[e.second] != b) {
+                            stamp[e.second] = b;
+                            bct.blocks[b].push_back(e.second);
+                        }
+                        if (e.first == p && e.second == x) break;
+                    }
+                }
+            }
+        }
+        
+        // Vértice isolado forma um bloco sozinho
+        if (rootChildren == 0) {
+            bct.blocks.push_back({r});
+            bct.blockEdges.emplace_back();
+        }
+    }
+    
+    // Vértices de corte são os que pertencem a mais de um bloco
+    int numBlocks = bct.blocks.size();
+    vector<int> membership(n, 0);
+    for (const auto& block : bct.blocks) {
+        for (int v : block) {
+            membership[v]++;
+        }
+    }
+    
+    vector<int> cutIndex(n, -1);
+    for (int v = 0; v < n; v++) {
+        if (membership[v] > 1) {
+            cutIndex[v] = bct.cutVertices.size();
+            bct.cutVertices.push_back(v);
+        }
+    }
+    
+    // Liga cada bloco aos vértices de corte que ele contém
+    bct.tree.resize(numBlocks + bct.cutVertices.size());
+    for (int b = 0; b < numBlocks; b++) {
+        for (int v : bct.blocks[b]) {
+            if (cutIndex[v] != -1) {
+                int c = numBlocks + cutIndex[v];
+                bct.tree[b].push_back(c);
+                bct.tree[c].push_back(b);
+            }
+        }
+    }
+    
+    return bct;
+}
+
+// Pares de separação de cada bloco: cada bloco é um subproblema independente
+vector<vector<pair<int, int>>> Graph::findSeparationPairsPerBlock(const BlockCutTree& bct, int threads) {
+    int numBlocks = bct.blocks.size();
+    vector<vector<pair<int, int>>> result(numBlocks);
+    
+    // Blocos maiores primeiro para equilibrar a carga entre as threads
+    vector<int> order(numBlocks);
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&bct](int a, int b) {
+        return bct.blockEdges[a].size() > bct.blockEdges[b].size();
+    });
+    
+    atomic<int> next(0);
+    auto worker = [&]() {
+        vector<int> local(n); // Numeração local dos vértices do bloco
+        
+        while (true) {
+            int i = next++;
+            if (i >= numBlocks) break;
+            
+            int b = order[i];
+            const vector<int>& vertices = bct.blocks[b];
+            if (vertices.size() < 4) continue; // Sem pares de separação
+            
+            for (size_t k = 0; k < vertices.size(); k++) {
+                local[vertices[k]] = k;
+            }
+            
+            vector<pair<int, int>> edges;
+            edges.reserve(bct.blockEdges[b].size());
+            for (const auto& e : bct.blockEdges[b]) {
+                edges.push_back({local[e.first], local[e.second]});
+            }
+            
+            Triconnectivity spqr(vertices.size(), edges);
+            vector<pair<int, int>> pairs = spqr.separationPairs();
+            for (auto& p : pairs) {
+                int u = vertices[p.first], v = vertices[p.second];
+                p = {min(u, v), max(u, v)};
+            }
+            sort(pairs.begin(), pairs.end());
+            result[b] = move(pairs);
+        }
+    };
+    
+    if (threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    threads = min(threads, numBlocks);
+    
+    if (threads <= 1) {
+        worker();
+    } else {
+        vector<thread> pool;
+        for (int t = 0; t < threads; t++) {
+            pool.emplace_back(worker);
+        }
+        for (auto& t : pool) {
+            t.join();
+        }
+    }
+    
+    return result;
+}
+
 // Encontra pares de vértices de corte
+// Usa a decomposição em componentes triconexas: O(n + m + k), sendo k o número de pares
 vector<pair<int, int>> Graph::findCutVertexPairs() {
     // Se o grafo tem pontos de articulação ou não é conexo, não é 2-conexo
     if (!isConnected() || !findArticulationPoints().empty()) {
         return vector<pair<int, int>>();
     }
     
-    // Conjunto para armazenar pares de corte únicos
-    set<pair<int, int>> cutPairsSet;
+    return findSeparationPairs();
+}
+
+// Pares de separação de um grafo já sabidamente 2-conexo
+vector<pair<int, int>> Graph::findSeparationPairs() {
+    freeze();
+    
+    // Lista de arestas (cada aresta uma única vez)
+    vector<pair<int, int>> edges;
+    edges.reserve(m);
+    for (int u = 0; u < n; u++) {
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            if (u < targets[i]) {
+                edges.push_back({u, targets[i]});
+            }
+        }
+    }
+    
+    Triconnectivity spqr(n, edges);
+    return spqr.separationPairs();
+}
+
+// Encontra pares de vértices de corte testando todos os pares
+// As linhas i são distribuídas dinamicamente entre as threads (as primeiras
+// linhas são as mais longas); cada thread tem sua memória de trabalho e sua
+// lista de resultados, unidas e ordenadas ao final
+vector<pair<int, int>> Graph::findCutVertexPairsBruteForce(int threads) {
+    // Se o grafo tem pontos de articulação ou não é conexo, não é 2-conexo
+    if (!isConnected() || !findArticulationPoints().empty()) {
+        return vector<pair<int, int>>();
+    }
+    
+    if (threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    threads = max(1, min(threads, n));
+    
+    atomic<int> nextRow(0);
+    vector<vector<pair<int, int>>> found(threads);
     
-    // Para grafos menores, usamos força bruta
-    if (n <= 1000) {
-        for (int i = 0; i < n; i++) {
+    auto worker = [&](int t) {
+        TraversalContext ctx(n);
+        int i;
+        while ((i = nextRow++) < n) {
             for (int j = i + 1; j < n; j++) {
-                if (isCutPair(i, j)) {
-                    cutPairsSet.insert({i, j});
+                if (isCutPair(i, j, ctx)) {
+                    found[t].push_back({i, j});
                 }
             }
         }
+    };
+    
+    if (threads == 1) {
+        worker(0);
     } else {
-        // Para grafos maiores, usamos uma abordagem mais sofisticada
-        // Verifica apenas pares estratégicos com base na estrutura do grafo
-        
-        // Construímos conjuntos de vizinhos para cada vértice
-        vector<unordered_set<int>> neighbors(n);
-        
-        for (int i = 0; i < n; i++) {
-            for (int j : adj[i]) {
-                neighbors[i].insert(j);
-            }
+        vector<thread> pool;
+        for (int t = 0; t < threads; t++) {
+            pool.emplace_back(worker, t);
         }
-        
-        // Verifica pares de vértices
-        for (int i = 0; i < n; i++) {
-            for (int j = i + 1; j < n; j++) {
-                // Pula se i e j estão diretamente conectados
-                if (neighbors[i].find(j) != neighbors[i].end()) {
-                    continue;
-                }
-                
-                // Encontra vizinhos comuns
-                vector<int> commonNeighbors;
-                for (int neighbor : neighbors[i]) {
-                    if (neighbors[j].find(neighbor) != neighbors[j].end()) {
-                        commonNeighbors.push_back(neighbor);
-                    }
-                }
-                
-                // Se têm vizinhos em comum, verifica se formam um par de corte
-                if (!commonNeighbors.empty() && isCutPair(i, j)) {
-                    cutPairsSet.insert({i, j});
-                }
-            }
+        for (auto& t : pool) {
+            t.join();
         }
     }
     
-    // Converte o conjunto para um vetor e ordena
-    vector<pair<int, int>> cutPairs(cutPairsSet.begin(), cutPairsSet.end());
+    // Junta os resultados de todas as threads
+    vector<pair<int, int>> cutPairs;
+    for (const auto& part : found) {
+        cutPairs.insert(cutPairs.end(), part.begin(), part.end());
+    }
+    sort(cutPairs.begin(), cutPairs.end());
+    
     return cutPairs;
 }
 
 // Verifica se remover os vértices u e v desconecta o grafo
 bool Graph::isCutPair(int u, int v) {
     if (n <= 2) return false;
+    freeze();
     
-    vector<bool> visited(n, false);
-    visited[u] = visited[v] = true;
+    return isCutPair(u, v, cutPairContext);
+}
+
+// Verifica se remover os vértices u e v desconecta o grafo (memória de quem chama)
+// Não aloca memória nem percorre o vetor de marcas: a cobertura é uma comparação
+bool Graph::isCutPair(int u, int v, TraversalContext& ctx) {
+    if (n <= 2) return false;
+    
+    // Marca u e v como visitados sem contá-los
+    ctx.reset();
+    ctx.stamp[u] = ctx.stamp[v] = ctx.epoch;
     
     // Encontra um vértice inicial diferente de u e v
     int start = 0;
     while (start == u || start == v) start++;
     
     // Realiza DFS a partir de start, excluindo u e v
-    dfsExcluding(start, u, v, visited);
+    dfsExcluding(start, u, v, ctx);
     
-    // Verifica se todos os vértices (exceto u e v) foram visitados
-    for (int i = 0; i < n; i++) {
-        if (i != u && i != v && !visited[i]) {
-            return true; // Encontrou um vértice não alcançável
-        }
-    }
-    
-    return false;
+    // Algum vértice (exceto u e v) não foi alcançado?
+    int remaining = n - (u == v ? 1 : 2);
+    return ctx.visitedCount < remaining;
 }
 
-// DFS excluindo dois vértices específicos
-void Graph::dfsExcluding(int vertex, int exclude1, int exclude2, vector<bool>& visited) {
-    visited[vertex] = true;
+// DFS excluindo dois vértices específicos (pilha explícita)
+void Graph::dfsExcluding(int vertex, int exclude1, int exclude2, TraversalContext& ctx) {
+    vector<int>& stackVertex = ctx.stackVertex;
+    vector<int>& stackIndex = ctx.stackIndex;
     
-    for (int neighbor : adj[vertex]) {
-        if (neighbor != exclude1 && neighbor != exclude2 && !visited[neighbor]) {
-            dfsExcluding(neighbor, exclude1, exclude2, visited);
+    int top = 0;
+    stackVertex[0] = vertex;
+    stackIndex[0] = offsets[vertex];
+    ctx.visit(vertex);
+    
+    while (top >= 0) {
+        int x = stackVertex[top];
+        
+        if (stackIndex[top] < offsets[x + 1]) {
+            int neighbor = targets[stackIndex[top]++];
+            if (neighbor != exclude1 && neighbor != exclude2 && !ctx.visited(neighbor)) {
+                ctx.visit(neighbor);
+                top++;
+                stackVertex[top] = neighbor;
+                stackIndex[top] = offsets[neighbor];
+            }
+        } else {
+            top--;
         }
     }
 }
 
 // Determina a conectividade do grafo (0, 1, 2 ou pelo menos 3)
-int Graph::getConnectivity() {
+// Uma única decomposição em blocos responde tudo: a floresta bloco-corte dá a
+// conexidade e os vértices de corte, e os pares de separação são buscados em
+// cada bloco de forma independente (em paralelo), já com os ids globais
+Connectivity Graph::getConnectivity(bool allBlocks, int threads) {
+    Connectivity result;
+    result.blockCutTree = findBlockCutTree();
+    const BlockCutTree& bct = result.blockCutTree;
+    
+    // A floresta bloco-corte tem uma árvore por componente (nós menos arestas)
+    long long treeNodes = bct.tree.size();
+    long long treeEdges = 0;
+    for (size_t b = 0; b < bct.blocks.size(); b++) {
+        treeEdges += bct.tree[b].size();
+    }
+    bool connected = treeNodes - treeEdges <= 1;
+    
+    // Sem vértices de corte o nível depende dos pares do bloco; nos demais
+    // casos a saída não lista pares e os blocos só são analisados com allBlocks
+    if (allBlocks || (connected && bct.cutVertices.empty())) {
+        result.blockPairs = findSeparationPairsPerBlock(bct, threads);
+    }
+    
     // Um grafo é 0-conexo se não for conexo
-    if (!isConnected()) return 0;
+    result.level = 0;
+    if (!connected) return result;
     
-    // Um grafo é 1-conexo se tiver pontos de articulação
-    vector<int> artPoints = findArticulationPoints();
-    if (!artPoints.empty()) return 1;
+    // Um grafo é 1-conexo se tiver pontos de articulação (os vértices de corte)
+    result.level = 1;
+    result.articulationPoints = bct.cutVertices;
+    if (!result.articulationPoints.empty()) return result;
     
-    // Um grafo é 2-conexo se tiver pares de vértices de corte
-    vector<pair<int, int>> cutPairs = findCutVertexPairs();
-    if (!cutPairs.empty()) return 2;
+    // Um grafo é 2-conexo se tiver pares de vértices de corte; sem vértices de
+    // corte há um só bloco, e os seus pares são os do grafo
+    result.level = 2;
+    for (const auto& pairs : result.blockPairs) {
+        result.cutPairs.insert(result.cutPairs.end(), pairs.begin(), pairs.end());
+    }
+    if (!result.cutPairs.empty()) {
+        sort(result.cutPairs.begin(), result.cutPairs.end());
+        return result;
+    }
     
     // Se não for nenhum dos anteriores, é pelo menos 3-conexo
-    return 3;
+    result.level = 3;
+    return result;
 }
\ No newline at end of file
@@ -3,16 +3,74 @@
 #include <vector>
 #include <set>
 #include <unordered_set>
+#include <limits>
+#include <algorithm>
 
 using namespace std;
 
+// Árvore bloco-corte: os nós 0..B-1 são os blocos (componentes 2-conexas)
+// e os nós B..B+C-1 são os vértices de corte, na ordem de cutVertices
+struct BlockCutTree {
+    vector<vector<int>> blocks;                 // Vértices de cada bloco
+    vector<vector<pair<int, int>>> blockEdges;  // Arestas de cada bloco
+    vector<int> cutVertices;                    // Vértices de corte (ordem crescente)
+    vector<vector<int>> tree;                   // Adjacência da árvore
+};
+
+// Memória de trabalho de uma DFS com exclusão (cada thread usa a sua)
+// As marcas de visita são carimbos de geração: uma nova busca apenas
+// incrementa epoch, sem limpar o vetor, e visitedCount dá a cobertura
+struct TraversalContext {
+    vector<int> stamp;       // Geração em que cada vértice foi marcado
+    int epoch;               // Geração da busca atual
+    int visitedCount;        // Vértices visitados na busca atual
+    vector<int> stackVertex;
+    vector<int> stackIndex;
+    
+    TraversalContext(int n) : stamp(n, 0), epoch(0), visitedCount(0), stackVertex(n), stackIndex(n) {}
+    
+    // Inicia uma nova busca (as marcas anteriores deixam de valer)
+    void reset() {
+        if (++epoch == numeric_limits<int>::max()) {
+            fill(stamp.begin(), stamp.end(), 0);
+            epoch = 1;
+        }
+        visitedCount = 0;
+    }
+    
+    bool visited(int v) const { return stamp[v] == epoch; }
+    void visit(int v) { stamp[v] = epoch; visitedCount++; }
+};
+
+// Resultado de getConnectivity: o nível, a lista que o caracteriza e a
+// decomposição em blocos de onde ela saiu (reaproveitada por --blocks)
+struct Connectivity {
+    int level;                          // 0, 1, 2 ou 3 (pelo menos 3-conexo)
+    vector<int> articulationPoints;     // Nível 1 (ordem crescente)
+    vector<pair<int, int>> cutPairs;    // Nível 2 (ordem crescente)
+    BlockCutTree blockCutTree;
+    vector<vector<pair<int, int>>> blockPairs; // Pares de cada bloco (vazio se não analisados)
+};
+
 // Classe para representar um grafo não orientado
 class Graph {
     public:
 
     int n; // Número de vértices
     int m; // Número de arestas
-    vector<vector<int>> adj; // Lista de adjacência
+    
+    // Adjacência em formato CSR: os vizinhos de u são
+    // targets[offsets[u]] ... targets[offsets[u + 1] - 1]
+    vector<int> offsets;
+    vector<int> targets;
+    vector<pair<int, int>> pending; // Arestas ainda não incorporadas ao CSR
+    bool frozen;                    // CSR atualizado (sem arestas pendentes)
+    
+    TraversalContext cutPairContext; // Memória reutilizada por isCutPair(u, v)
+    
+    // Quadros pré-alocados das DFS iterativas (profundidade máxima n)
+    vector<int> stackVertex; // Vértice de cada quadro
+    vector<int> stackIndex;  // Próxima posição de targets a explorar em cada quadro
 
     // Função auxiliar para DFS
     void dfs(int v, vector<bool>& visited);
@@ -21,8 +79,8 @@ class Graph {
     void dfsAP(int u, int parent, vector<int>& disc, vector<int>& low, 
                vector<bool>& ap, int& time);
     
-    // DFS excluindo dois vértices específicos
-    void dfsExcluding(int vertex, int exclude1, int exclude2, vector<bool>& visited);
+    // DFS excluindo dois vértices específicos (usa a pilha e as marcas do contexto)
+    void dfsExcluding(int vertex, int exclude1, int exclude2, TraversalContext& ctx);
 
     // Construtor
     Graph(int vertices, int edges);
@@ -30,18 +88,46 @@ class Graph {
     // Adiciona uma aresta ao grafo
     void addEdge(int u, int v);
     
+    // Incorpora as arestas pendentes ao CSR (chamado pelas consultas)
+    void freeze();
+    
     // Verifica se o grafo é conexo
     bool isConnected();
     
     // Algoritmo de Tarjan para encontrar pontos de articulação
     vector<int> findArticulationPoints();
     
-    // Encontra pares de vértices de corte
+    // Decompõe o grafo em blocos (Tarjan-Hopcroft) e monta a árvore bloco-corte
+    BlockCutTree findBlockCutTree();
+    
+    // Pares de separação de cada bloco, analisados em paralelo
+    // (threads = 0 usa todos os núcleos disponíveis)
+    vector<vector<pair<int, int>>> findSeparationPairsPerBlock(const BlockCutTree& bct, int threads = 0);
+    
+    // Encontra pares de vértices de corte (decomposição em componentes triconexas)
     vector<pair<int, int>> findCutVertexPairs();
     
-    // Verifica se remover os vértices u e v desconecta o grafo
+    // Pares de separação de um grafo já sabidamente 2-conexo
+    vector<pair<int, int>> findSeparationPairs();
+    
+    // Encontra pares de vértices de corte testando todos os pares (referência
+    // dos testes), distribuindo as linhas i entre threads (threads = 0 usa
+    // todos os núcleos)
+    vector<pair<int, int>> findCutVertexPairsBruteForce(int threads = 0);
+    
+    // Verifica se remover os vértices u e v desconecta o grafo (u == v remove
+    // um só vértice); referência por força bruta usada pelos testes
     bool isCutPair(int u, int v);
     
-    // Determina a conectividade do grafo (0, 1, 2 ou pelo menos 3)
-    int getConnectivity();
+    // Mesmo teste usando a memória de trabalho de quem chama (grafo já congelado)
+    bool isCutPair(int u, int v, TraversalContext& ctx);
+    
+    // Determina a conectividade do grafo (0, 1, 2 ou pelo menos 3) pela árvore
+    // bloco-corte, com os blocos analisados em paralelo por
+    // findSeparationPairsPerBlock (threads = 0 usa todos os núcleos). Devolve os
+    // pontos de articulação (nível 1) ou os pares de corte (nível 2)
+    // encontrados, para que quem chama não repita a decomposição.
+    // Os blocos só são analisados quando o nível depende deles (sem vértices
+    // de corte) ou com allBlocks: a lista de pares pode ser quadrática
+    Connectivity getConnectivity(bool allBlocks = false, int threads = 0);
 };
\ No newline at end of file
@@ -1,53 +1,98 @@
 #include <iostream>
 #include <algorithm>
+#include <string>
 #include "graph.hpp"
+#include "fast-input.hpp"
 
 using namespace std;
 
-int main() {
-    // Leitura dos dados do grafo
-    int n, m;
-    cin >> n >> m;
+// Imprime a árvore bloco-corte e os pares de separação de cada bloco,
+// já calculados por getConnectivity
+void printBlockCutTree(const Connectivity& connectivity) {
+    const BlockCutTree& bct = connectivity.blockCutTree;
+    const vector<vector<pair<int, int>>>& blockPairs = connectivity.blockPairs;
+    int numBlocks = bct.blocks.size();
+    
+    cout << "Blocos: " << numBlocks << endl;
+    for (int b = 0; b < numBlocks; b++) {
+        vector<int> vertices = bct.blocks[b];
+        sort(vertices.begin(), vertices.end());
+        
+        cout << "Bloco " << b << ":";
+        for (int v : vertices) {
+            cout << " " << v;
+        }
+        cout << endl;
+        
+        for (const auto& pair : blockPairs[b]) {
+            cout << "  " << pair.first << " " << pair.second << endl;
+        }
+    }
+    
+    // Cada vértice de corte seguido dos blocos que ele liga
+    cout << "Vértices de corte: " << bct.cutVertices.size() << endl;
+    for (size_t c = 0; c < bct.cutVertices.size(); c++) {
+        cout << bct.cutVertices[c] << ":";
+        for (int b : bct.tree[numBlocks + c]) {
+            cout << " " << b;
+        }
+        cout << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    ios_base::sync_with_stdio(false);
+    
+    // Leitura dos dados do grafo (texto ou formato binário)
+    FastInput input;
+    int n = input.nextInt();
+    int m = input.nextInt();
     
     // Criação do grafo
     Graph graph(n, m);
     
     // Leitura e adição das arestas
     for (int i = 0; i < m; i++) {
-        int u, v;
-        cin >> u >> v;
+        int u = input.nextInt();
+        int v = input.nextInt();
         graph.addEdge(u, v);
     }
     
-    // Determina a conectividade do grafo
-    int connectivity = graph.getConnectivity();
+    // Monta a adjacência compacta (CSR) a partir das arestas lidas
+    graph.freeze();
+    
+    // Modo opcional: decomposição em blocos (--blocks)
+    bool printBlocks = argc > 1 && string(argv[1]) == "--blocks";
+    
+    // Determina a conectividade do grafo (com as listas já calculadas); com
+    // --blocks os pares de separação de todos os blocos também são buscados
+    Connectivity connectivity = graph.getConnectivity(printBlocks);
     
     // Imprime o resultado conforme o enunciado
-    if (connectivity == 0) {
+    if (connectivity.level == 0) {
         cout << "Grafo desconexo." << endl;
-    } else if (connectivity == 1) {
+    } else if (connectivity.level == 1) {
         cout << "Grafo 1-conexo." << endl;
         
         // Lista os pontos de articulação
-        vector<int> artPoints = graph.findArticulationPoints();
-        sort(artPoints.begin(), artPoints.end());
-        
-        for (int point : artPoints) {
-            cout << point << endl;
+        for (int point : connectivity.articulationPoints) {
+            cout << point << '\n';
         }
-    } else if (connectivity == 2) {
+    } else if (connectivity.level == 2) {
         cout << "Grafo 2-conexo." << endl;
         
         // Lista os pares de vértices de corte
-        vector<pair<int, int>> cutPairs = graph.findCutVertexPairs();
-        sort(cutPairs.begin(), cutPairs.end());
-        
-        for (const auto& pair : cutPairs) {
-            cout << pair.first << " " << pair.second << endl;
+        for (const auto& pair : connectivity.cutPairs) {
+            cout << pair.first << " " << pair.second << '\n';
         }
     } else {
         cout << "Grafo 3-conexo." << endl;
     }
     
+    // Imprime a decomposição em blocos já calculada
+    if (printBlocks) {
+        printBlockCutTree(connectivity);
+    }
+    
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+// Teste de Graph::getConnectivity contra uma referência por força bruta:
+// cada vértice e cada par de vértices é removido e a conexidade do restante
+// é verificada por Graph::isCutPair (DFS com marcas de geração, sem alocar
+// por consulta); os pares vêm de Graph::findCutVertexPairsBruteForce, que
+// divide as linhas entre threads. Cobre grafos fixos e aleatórios pequenos.
+
+#include "graph.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool condition, const string& description) {
+    if (!condition) {
+        cerr << "FALHOU: " << description << endl;
+        failures++;
+    }
+}
+
+// Conectividade de referência com as listas correspondentes
+static Connectivity bruteForce(Graph& g) {
+    g.freeze();
+    Connectivity result;
+    result.level = 3;
+
+    // Conexidade: DFS a partir de 0 sem remover vértices
+    vector<bool> visited(g.n, false);
+    vector<int> stack = {0};
+    visited[0] = true;
+    int count = 1;
+    while (!stack.empty()) {
+        int x = stack.back();
+        stack.pop_back();
+        for (int i = g.offsets[x]; i < g.offsets[x + 1]; i++) {
+            if (!visited[g.targets[i]]) {
+                visited[g.targets[i]] = true;
+                count++;
+                stack.push_back(g.targets[i]);
+            }
+        }
+    }
+    if (count < g.n) {
+        result.level = 0;
+        return result;
+    }
+
+    for (int u = 0; u < g.n; u++) {
+        if (g.isCutPair(u, u)) result.articulationPoints.push_back(u);
+    }
+    if (!result.articulationPoints.empty()) {
+        result.level = 1;
+        return result;
+    }
+
+    // Pares pela força bruta paralela (linhas divididas entre 3 threads,
+    // cada uma com a sua memória de trabalho e a sua lista de resultados)
+    result.cutPairs = g.findCutVertexPairsBruteForce(3);
+    if (!result.cutPairs.empty()) result.level = 2;
+    return result;
+}
+
+static void compare(const vector<pair<int, int>>& edges, int n, const string& name) {
+    Graph fast(n, edges.size());
+    Graph reference(n, edges.size());
+    for (const auto& e : edges) {
+        fast.addEdge(e.first, e.second);
+        reference.addEdge(e.first, e.second);
+    }
+    fast.freeze();
+
+    Connectivity got = fast.getConnectivity();
+    Connectivity expected = bruteForce(reference);
+    check(got.level == expected.level, name + ": nível");
+    check(got.articulationPoints == expected.articulationPoints, name + ": pontos de articulação");
+    check(got.cutPairs == expected.cutPairs, name + ": pares de corte");
+
+    // Com todos os blocos analisados em paralelo o resultado é o mesmo
+    Connectivity all = fast.getConnectivity(true, 3);
+    check(all.level == got.level && all.articulationPoints == got.articulationPoints &&
+          all.cutPairs == got.cutPairs, name + ": allBlocks");
+    check(all.blockPairs.size() == all.blockCutTree.blocks.size(), name + ": pares por bloco");
+}
+
+int main() {
+    // Grafos fixos: desconexo, caminho, ciclo e completo
+    compare({{0, 1}, {2, 3}}, 4, "desconexo");
+    compare({{0, 1}, {1, 2}, {2, 3}}, 4, "caminho");
+    compare({{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 0}}, 5, "ciclo C5");
+    compare({{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}}, 4, "K4");
+
+    // Grafos aleatórios conexos (árvore geradora mais arestas extras)
+    srand(12345);
+    for (int trial = 0; trial < 500; trial++) {
+        int n = 4 + rand() % 9;
+        vector<pair<int, int>> edges;
+        vector<vector<bool>> used(n, vector<bool>(n, false));
+        for (int v = 1; v < n; v++) {
+            int u = rand() % v;
+            edges.push_back({u, v});
+            used[u][v] = used[v][u] = true;
+        }
+        int extra = rand() % (2 * n);
+        for (int k = 0; k < extra; k++) {
+            int u = rand() % n, v = rand() % n;
+            if (u == v || used[u][v]) continue;
+            edges.push_back({u, v});
+            used[u][v] = used[v][u] = true;
+        }
+        compare(edges, n, "aleatório " + to_string(trial));
+    }
+
+    if (failures == 0) {
+        cout << "cut-pairs: OK" << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,688 @@
+#include "triconnectivity.hpp"
+#include <algorithm>
+
+using namespace std;
+
+// ===== Listas encadeadas com remoção em O(1) =====
+
+void Triconnectivity::ListPool::init(int lists) {
+    value.clear();
+    prev.clear();
+    next.clear();
+    owner.clear();
+    head.assign(lists, -1);
+    tail.assign(lists, -1);
+    length.assign(lists, 0);
+}
+
+int Triconnectivity::ListPool::pushBack(int list, int val) {
+    int slot = value.size();
+    value.push_back(val);
+    prev.push_back(tail[list]);
+    next.push_back(-1);
+    owner.push_back(list);
+
+    if (tail[list] != -1) {
+        next[tail[list]] = slot;
+    } else {
+        head[list] = slot;
+    }
+    tail[list] = slot;
+    length[list]++;
+    return slot;
+}
+
+int Triconnectivity::ListPool::pushFront(int list, int val) {
+    int slot = value.size();
+    value.push_back(val);
+    prev.push_back(-1);
+    next.push_back(head[list]);
+    owner.push_back(list);
+
+    if (head[list] != -1) {
+        prev[head[list]] = slot;
+    } else {
+        tail[list] = slot;
+    }
+    head[list] = slot;
+    length[list]++;
+    return slot;
+}
+
+void Triconnectivity::ListPool::erase(int slot) {
+    int list = owner[slot];
+    if (list == -1) return;
+
+    if (prev[slot] != -1) {
+        next[prev[slot]] = next[slot];
+    } else {
+        head[list] = next[slot];
+    }
+    if (next[slot] != -1) {
+        prev[next[slot]] = prev[slot];
+    } else {
+        tail[list] = prev[slot];
+    }
+    length[list]--;
+    owner[slot] = -1;
+}
+
+// ===== Construção da decomposição =====
+
+// Construtor: descarta laços e arestas paralelas e executa a decomposição
+Triconnectivity::Triconnectivity(int vertices, const vector<pair<int, int>>& edges)
+    : n(vertices), realEdges(0) {
+    // Agrupa as arestas pelo menor extremo (ordenação por contagem)
+    vector<int> offset(n + 1, 0);
+    for (const auto& e : edges) {
+        if (e.first != e.second) {
+            offset[min(e.first, e.second) + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        offset[i + 1] += offset[i];
+    }
+
+    vector<int> higher(offset[n]);
+    vector<int> pos(offset.begin(), offset.end() - 1);
+    for (const auto& e : edges) {
+        if (e.first != e.second) {
+            higher[pos[min(e.first, e.second)]++] = max(e.first, e.second);
+        }
+    }
+
+    // Marca os vizinhos já vistos de cada vértice para ignorar repetições
+    vector<int> mark(n, -1);
+    for (int u = 0; u < n; u++) {
+        for (int i = offset[u]; i < offset[u + 1]; i++) {
+            int v = higher[i];
+            if (mark[v] != u) {
+                mark[v] = u;
+                newEdge(u, v, UNSEEN);
+            }
+        }
+    }
+    realEdges = src.size();
+
+    // Com menos de 4 vértices não existem pares de separação
+    if (n >= 4) {
+        splitComponents();
+    }
+}
+
+int Triconnectivity::newEdge(int u, int v, EdgeType t) {
+    src.push_back(u);
+    tgt.push_back(v);
+    type.push_back(t);
+    start.push_back(0);
+    inAdj.push_back(-1);
+    inHigh.push_back(-1);
+    return src.size() - 1;
+}
+
+int Triconnectivity::newComponent(CompType t) {
+    components.push_back({vector<int>(), t});
+    return components.size() - 1;
+}
+
+// Divide o grafo em componentes de separação
+void Triconnectivity::splitComponents() {
+    dfs1();
+    buildAcceptableAdjStruct();
+    pathFinder();
+    pathSearch();
+
+    // As arestas restantes na pilha formam a última componente
+    int c = newComponent(TRICONNECTED);
+    while (!estack.empty()) {
+        components[c].edges.push_back(estack.back());
+        estack.pop_back();
+    }
+}
+
+// Primeira DFS: numeração, orientação das arestas, lowpt1, lowpt2 e ND
+void Triconnectivity::dfs1() {
+    // Lista de arestas incidentes em cada vértice
+    vector<int> offset(n + 1, 0);
+    for (int e = 0; e < realEdges; e++) {
+        offset[src[e] + 1]++;
+        offset[tgt[e] + 1]++;
+    }
+    for (int i = 0; i < n; i++) {
+        offset[i + 1] += offset[i];
+    }
+    vector<int> incident(2 * realEdges);
+    vector<int> pos(offset.begin(), offset.end() - 1);
+    for (int e = 0; e < realEdges; e++) {
+        incident[pos[src[e]]++] = e;
+        incident[pos[tgt[e]]++] = e;
+    }
+
+    number.assign(n, 0);
+    lowpt1.assign(n, 0);
+    lowpt2.assign(n, 0);
+    nd.assign(n, 1);
+    father.assign(n, -1);
+    treeArc.assign(n, -1);
+    degree.assign(n, 0);
+    for (int v = 0; v < n; v++) {
+        degree[v] = offset[v + 1] - offset[v];
+    }
+
+    // DFS com pilha explícita: (vértice, próxima aresta incidente)
+    int count = 0;
+    vector<pair<int, int>> stack;
+    number[0] = lowpt1[0] = lowpt2[0] = ++count;
+    stack.push_back({0, offset[0]});
+
+    while (!stack.empty()) {
+        int v = stack.back().first;
+
+        if (stack.back().second < offset[v + 1]) {
+            int e = incident[stack.back().second++];
+            if (type[e] != UNSEEN) continue;
+
+            int w = (src[e] == v) ? tgt[e] : src[e];
+            src[e] = v;
+            tgt[e] = w;
+
+            if (number[w] == 0) {
+                type[e] = TREE;
+                treeArc[w] = e;
+                father[w] = v;
+                number[w] = lowpt1[w] = lowpt2[w] = ++count;
+                stack.push_back({w, offset[w]});
+            } else {
+                type[e] = FROND;
+                if (number[w] < lowpt1[v]) {
+                    lowpt2[v] = lowpt1[v];
+                    lowpt1[v] = number[w];
+                } else if (number[w] > lowpt1[v]) {
+                    lowpt2[v] = min(lowpt2[v], number[w]);
+                }
+            }
+        } else {
+            stack.pop_back();
+            int u = father[v];
+            if (u == -1) continue;
+
+            // Atualiza os lowpts do pai a partir do filho v
+            if (lowpt1[v] < lowpt1[u]) {
+                lowpt2[u] = min(lowpt1[u], lowpt2[v]);
+                lowpt1[u] = lowpt1[v];
+            } else if (lowpt1[v] == lowpt1[u]) {
+                lowpt2[u] = min(lowpt2[u], lowpt2[v]);
+            } else {
+                lowpt2[u] = min(lowpt2[u], lowpt1[v]);
+            }
+            nd[u] += nd[v];
+        }
+    }
+}
+
+// Ordena as listas de adjacência pelo valor phi (ordenação por contagem)
+void Triconnectivity::buildAcceptableAdjStruct() {
+    int maxPhi = 3 * n + 2;
+    vector<int> phi(realEdges);
+    vector<int> bucket(maxPhi + 2, 0);
+
+    for (int e = 0; e < realEdges; e++) {
+        int v = src[e], w = tgt[e];
+        if (type[e] == FROND) {
+            phi[e] = 3 * number[w] + 1;
+        } else if (lowpt2[w] < number[v]) {
+            phi[e] = 3 * lowpt1[w];
+        } else {
+            phi[e] = 3 * lowpt1[w] + 2;
+        }
+        bucket[phi[e] + 1]++;
+    }
+    for (int i = 0; i <= maxPhi; i++) {
+        bucket[i + 1] += bucket[i];
+    }
+
+    vector<int> order(realEdges);
+    for (int e = 0; e < realEdges; e++) {
+        order[bucket[phi[e]]++] = e;
+    }
+
+    adjacency.init(n);
+    for (int e : order) {
+        inAdj[e] = adjacency.pushBack(src[e], e);
+    }
+}
+
+// Segunda DFS: renumeração, arestas de início de caminho e listas HIGHPT
+void Triconnectivity::pathFinder() {
+    newnum.assign(n, 0);
+    highpt.init(n);
+
+    int count = n;
+    bool newPath = true;
+    vector<pair<int, int>> stack; // (vértice, posição atual na adjacência)
+    newnum[0] = count - nd[0] + 1;
+    stack.push_back({0, adjacency.head[0]});
+
+    while (!stack.empty()) {
+        int v = stack.back().first;
+        int slot = stack.back().second;
+
+        if (slot == -1) {
+            stack.pop_back();
+            if (!stack.empty()) count--;
+            continue;
+        }
+        stack.back().second = adjacency.next[slot];
+
+        int e = adjacency.value[slot];
+        int w = tgt[e];
+        if (newPath) {
+            newPath = false;
+            start[e] = 1;
+        }
+
+        if (type[e] == TREE) {
+            newnum[w] = count - nd[w] + 1;
+            stack.push_back({w, adjacency.head[w]});
+        } else {
+            inHigh[e] = highpt.pushBack(w, newnum[v]);
+            newPath = true;
+        }
+    }
+
+    // Converte os lowpts para a nova numeração
+    vector<int> oldToNew(n + 1);
+    for (int v = 0; v < n; v++) {
+        oldToNew[number[v]] = newnum[v];
+    }
+    nodeAt.assign(n + 1, -1);
+    for (int v = 0; v < n; v++) {
+        nodeAt[newnum[v]] = v;
+        lowpt1[v] = oldToNew[lowpt1[v]];
+        lowpt2[v] = oldToNew[lowpt2[v]];
+    }
+}
+
+int Triconnectivity::high(int v) const {
+    int slot = highpt.head[v];
+    return (slot == -1) ? 0 : highpt.value[slot];
+}
+
+void Triconnectivity::delHigh(int e) {
+    if (inHigh[e] != -1) {
+        highpt.erase(inHigh[e]);
+        inHigh[e] = -1;
+    }
+}
+
+// Número do destino da primeira aresta de v (maior que v se for um filho)
+int Triconnectivity::firstChild(int v) const {
+    int slot = adjacency.head[v];
+    return (slot == -1) ? 0 : newnum[tgt[adjacency.value[slot]]];
+}
+
+void Triconnectivity::pushTriple(int h, int a, int b) {
+    tstack.push_back({h, a, b});
+}
+
+bool Triconnectivity::tstackNotEOS() const {
+    return tstack.back().a != -1;
+}
+
+// Busca dos pares de separação sobre a decomposição em caminhos
+void Triconnectivity::pathSearch() {
+    tstack.clear();
+    estack.clear();
+    pushTriple(0, -1, 0); // EOS
+
+    int root = nodeAt[1];
+    vector<Frame> frames;
+    frames.push_back({root, adjacency.head[root], -1, adjacency.length[root], -1, -1});
+
+    while (!frames.empty()) {
+        Frame& f = frames.back();
+
+        if (f.slot == -1) {
+            frames.pop_back();
+            if (!frames.empty()) {
+                afterChild(frames.back());
+                frames.back().slot = frames.back().next;
+            }
+            continue;
+        }
+
+        int v = f.v, vnum = newnum[v];
+        int e = adjacency.value[f.slot];
+        int w = tgt[e], wnum = newnum[w];
+        f.next = adjacency.next[f.slot];
+
+        if (type[e] == TREE) {
+            if (start[e]) {
+                if (tstack.back().a > lowpt1[w]) {
+                    int y = 0, b;
+                    do {
+                        y = max(y, tstack.back().h);
+                        b = tstack.back().b;
+                        tstack.pop_back();
+                    } while (tstack.back().a > lowpt1[w]);
+                    pushTriple(y, lowpt1[w], b);
+                } else {
+                    pushTriple(wnum + nd[w] - 1, lowpt1[w], vnum);
+                }
+                pushTriple(0, -1, 0); // EOS
+            }
+
+            f.edge = e;
+            f.child = w;
+            frames.push_back({w, adjacency.head[w], -1, adjacency.length[w], -1, -1});
+        } else {
+            if (start[e]) {
+                if (tstack.back().a > wnum) {
+                    int y = 0, b;
+                    do {
+                        y = max(y, tstack.back().h);
+                        b = tstack.back().b;
+                        tstack.pop_back();
+                    } while (tstack.back().a > wnum);
+                    pushTriple(y, wnum, b);
+                } else {
+                    pushTriple(vnum, wnum, vnum);
+                }
+            }
+
+            estack.push_back(e);
+            f.slot = f.next;
+        }
+    }
+}
+
+// Trecho da busca executado ao retornar do filho (pares do tipo 2 e do tipo 1)
+void Triconnectivity::afterChild(Frame& f) {
+    int v = f.v, vnum = newnum[v];
+    int w = f.child, wnum = newnum[w];
+    int it = f.slot;
+    int root = nodeAt[1];
+
+    estack.push_back(treeArc[w]);
+
+    // Pares de separação do tipo 2
+    while (vnum != 1 && (tstack.back().a == vnum || (degree[w] == 2 && firstChild(w) > wnum))) {
+        int a = tstack.back().a;
+        int b = tstack.back().b;
+
+        if (a == vnum && father[nodeAt[b]] == nodeAt[a]) {
+            tstack.pop_back();
+            continue;
+        }
+
+        int eab = -1, eVirt, x;
+
+        if (degree[w] == 2 && firstChild(w) > wnum) {
+            int c = newComponent(POLYGON);
+            int e1 = estack.back();
+            estack.pop_back();
+            int e2 = estack.back();
+            estack.pop_back();
+            adjacency.erase(inAdj[e2]);
+
+            x = tgt[e2];
+            eVirt = newEdge(v, x, FROND);
+            degree[v]--;
+            degree[x]--;
+            components[c].edges = {e1, e2, eVirt};
+
+            if (!estack.empty()) {
+                int top = estack.back();
+                if (src[top] == x && tgt[top] == v) {
+                    eab = top;
+                    estack.pop_back();
+                    adjacency.erase(inAdj[eab]);
+                    delHigh(eab);
+                }
+            }
+        } else {
+            int h = tstack.back().h;
+            tstack.pop_back();
+
+            int c = newComponent(TRICONNECTED);
+            while (!estack.empty()) {
+                int xy = estack.back();
+                int xn = newnum[src[xy]], yn = newnum[tgt[xy]];
+                if (!(a <= xn && xn <= h && a <= yn && yn <= h)) break;
+
+                estack.pop_back();
+                if ((xn == a && yn == b) || (yn == a && xn == b)) {
+                    eab = xy;
+                    adjacency.erase(inAdj[eab]);
+                    delHigh(eab);
+                } else {
+                    if (it != inAdj[xy]) {
+                        adjacency.erase(inAdj[xy]);
+                        delHigh(xy);
+                    }
+                    components[c].edges.push_back(xy);
+                    degree[src[xy]]--;
+                    degree[tgt[xy]]--;
+                }
+            }
+
+            eVirt = newEdge(nodeAt[a], nodeAt[b], FROND);
+            components[c].edges.push_back(eVirt);
+            x = nodeAt[b];
+        }
+
+        if (eab != -1) {
+            int c = newComponent(BOND);
+            components[c].edges = {eab, eVirt};
+            eVirt = newEdge(v, x, FROND);
+            components[c].edges.push_back(eVirt);
+            degree[x]--;
+            degree[v]--;
+        }
+
+        estack.push_back(eVirt);
+        adjacency.value[it] = eVirt;
+        inAdj[eVirt] = it;
+        degree[x]++;
+        degree[v]++;
+        father[x] = v;
+        treeArc[x] = eVirt;
+        type[eVirt] = TREE;
+
+        w = x;
+        wnum = newnum[w];
+    }
+
+    // Par de separação do tipo 1
+    if (lowpt2[w] >= vnum && lowpt1[w] < vnum && (father[v] != root || f.outv >= 2)) {
+        int c = newComponent(TRICONNECTED);
+        int xn = 0, yn = 0;
+        while (!estack.empty()) {
+            int xy = estack.back();
+            xn = newnum[src[xy]];
+            yn = newnum[tgt[xy]];
+            if (!((wnum <= xn && xn < wnum + nd[w]) || (wnum <= yn && yn < wnum + nd[w]))) break;
+
+            estack.pop_back();
+            components[c].edges.push_back(xy);
+            delHigh(xy);
+            degree[src[xy]]--;
+            degree[tgt[xy]]--;
+        }
+
+        int low = nodeAt[lowpt1[w]];
+        int eVirt = newEdge(v, low, FROND);
+        components[c].edges.push_back(eVirt);
+
+        if ((xn == vnum && yn == lowpt1[w]) || (yn == vnum && xn == lowpt1[w])) {
+            int cb = newComponent(BOND);
+            int eh = estack.back();
+            estack.pop_back();
+            if (it != inAdj[eh]) {
+                adjacency.erase(inAdj[eh]);
+            }
+            components[cb].edges = {eh, eVirt};
+            eVirt = newEdge(v, low, FROND);
+            components[cb].edges.push_back(eVirt);
+            inHigh[eVirt] = inHigh[eh];
+            inHigh[eh] = -1;
+            degree[v]--;
+            degree[low]--;
+        }
+
+        if (low != father[v]) {
+            estack.push_back(eVirt);
+            adjacency.value[it] = eVirt;
+            inAdj[eVirt] = it;
+            if (inHigh[eVirt] == -1 && high(low) < vnum) {
+                inHigh[eVirt] = highpt.pushFront(low, vnum);
+            }
+            degree[v]++;
+            degree[low]++;
+        } else {
+            adjacency.erase(it);
+
+            int cb = newComponent(BOND);
+            components[cb].edges.push_back(eVirt);
+            eVirt = newEdge(low, v, TREE);
+            components[cb].edges.push_back(eVirt);
+
+            int eh = treeArc[v];
+            components[cb].edges.push_back(eh);
+            treeArc[v] = eVirt;
+            inAdj[eVirt] = inAdj[eh];
+            adjacency.value[inAdj[eh]] = eVirt;
+        }
+    }
+
+    if (start[f.edge]) {
+        while (tstackNotEOS()) {
+            tstack.pop_back();
+        }
+        tstack.pop_back();
+    }
+
+    while (tstackNotEOS() && tstack.back().b != vnum && high(v) > tstack.back().h) {
+        tstack.pop_back();
+    }
+
+    f.outv--;
+}
+
+// ===== Pares de separação a partir das componentes =====
+
+vector<pair<int, int>> Triconnectivity::separationPairs() const {
+    vector<pair<int, int>> pairs;
+    int comps = components.size();
+    if (comps == 0) return pairs;
+
+    // Classifica cada componente pela sua estrutura
+    vector<CompType> kind(comps);
+    vector<int> stamp(n, -1);
+    for (int c = 0; c < comps; c++) {
+        const vector<int>& edges = components[c].edges;
+        int distinct = 0;
+        for (int e : edges) {
+            if (stamp[src[e]] != c) { stamp[src[e]] = c; distinct++; }
+            if (stamp[tgt[e]] != c) { stamp[tgt[e]] = c; distinct++; }
+        }
+        if (distinct == 2) {
+            kind[c] = BOND;
+        } else if (distinct == (int)edges.size()) {
+            kind[c] = POLYGON;
+        } else {
+            kind[c] = TRICONNECTED;
+        }
+    }
+
+    // Cada aresta virtual aparece em exatamente duas componentes
+    int virtuals = src.size() - realEdges;
+    vector<int> sideA(virtuals, -1), sideB(virtuals, -1);
+    for (int c = 0; c < comps; c++) {
+        for (int e : components[c].edges) {
+            if (e < realEdges) continue;
+            if (sideA[e - realEdges] == -1) {
+                sideA[e - realEdges] = c;
+            } else {
+                sideB[e - realEdges] = c;
+            }
+        }
+    }
+
+    // Funde bonds adjacentes entre si e polígonos adjacentes entre si
+    vector<int> group(comps);
+    for (int c = 0; c < comps; c++) group[c] = c;
+    auto find = [&group](int c) {
+        while (group[c] != c) {
+            group[c] = group[group[c]];
+            c = group[c];
+        }
+        return c;
+    };
+
+    vector<char> merged(virtuals, 0);
+    for (int i = 0; i < virtuals; i++) {
+        int a = sideA[i], b = sideB[i];
+        if (a == -1 || b == -1) continue;
+        if (kind[a] == kind[b] && kind[a] != TRICONNECTED) {
+            group[find(a)] = find(b);
+            merged[i] = 1;
+        }
+    }
+
+    // Os extremos de toda aresta virtual restante formam um par de separação
+    for (int i = 0; i < virtuals; i++) {
+        if (merged[i] || sideB[i] == -1) continue;
+        int e = realEdges + i;
+        pairs.push_back({min(src[e], tgt[e]), max(src[e], tgt[e])});
+    }
+
+    // Em cada polígono, todo par de vértices não consecutivos é de separação
+    vector<vector<int>> cycleEdges(comps);
+    for (int c = 0; c < comps; c++) {
+        if (kind[c] != POLYGON) continue;
+        for (int e : components[c].edges) {
+            if (e >= realEdges && merged[e - realEdges]) continue;
+            cycleEdges[find(c)].push_back(e);
+        }
+    }
+
+    vector<int> nb1(n, -1), nb2(n, -1);
+    vector<int> cycle;
+    for (int c = 0; c < comps; c++) {
+        if (cycleEdges[c].size() < 4) continue;
+
+        for (int e : cycleEdges[c]) {
+            int u = src[e], w = tgt[e];
+            (nb1[u] == -1 ? nb1[u] : nb2[u]) = w;
+            (nb1[w] == -1 ? nb1[w] : nb2[w]) = u;
+        }
+
+        // Percorre o ciclo a partir de um vértice qualquer
+        cycle.clear();
+        int first = src[cycleEdges[c][0]];
+        int prev = -1, cur = first;
+        do {
+            cycle.push_back(cur);
+            int nxt = (nb1[cur] != prev) ? nb1[cur] : nb2[cur];
+            prev = cur;
+            cur = nxt;
+        } while (cur != first);
+
+        int k = cycle.size();
+        for (int i = 0; i < k; i++) {
+            for (int j = i + 2; j < k; j++) {
+                if (i == 0 && j == k - 1) continue;
+                pairs.push_back({min(cycle[i], cycle[j]), max(cycle[i], cycle[j])});
+            }
+        }
+
+        for (int v : cycle) {
+            nb1[v] = nb2[v] = -1;
+        }
+    }
+
+    sort(pairs.begin(), pairs.end());
+    pairs.erase(unique(pairs.begin(), pairs.end()), pairs.end());
+    return pairs;
+}
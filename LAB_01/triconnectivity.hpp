@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+// Decomposição de um grafo 2-conexo em componentes triconexas
+// (algoritmo de Hopcroft-Tarjan com as correções de Gutwenger-Mutzel).
+// As componentes são bonds (P), polígonos (S) ou grafos triconexos (R);
+// a partir delas todos os pares de separação são listados em O(n + m + k),
+// sendo k o número de pares encontrados.
+class Triconnectivity {
+    public:
+
+    // Constrói a decomposição a partir da lista de arestas de um grafo 2-conexo
+    // (laços e arestas paralelas são descartados)
+    Triconnectivity(int vertices, const vector<pair<int, int>>& edges);
+
+    // Retorna todos os pares de separação {u, v} (u < v), ordenados
+    vector<pair<int, int>> separationPairs() const;
+
+    private:
+
+    enum EdgeType { UNSEEN, TREE, FROND, REMOVED };
+    enum CompType { BOND, POLYGON, TRICONNECTED };
+
+    // Componente de separação: conjunto de arestas (reais ou virtuais)
+    struct Component {
+        vector<int> edges;
+        CompType type;
+    };
+
+    // Listas duplamente encadeadas em um único pool, com remoção em O(1)
+    // a partir da posição (necessária para as listas de adjacência e HIGHPT)
+    struct ListPool {
+        vector<int> value, prev, next, owner;
+        vector<int> head, tail, length;
+
+        void init(int lists);
+        int pushBack(int list, int val);
+        int pushFront(int list, int val);
+        void erase(int slot);
+    };
+
+    // Triplas (h, a, b) da pilha TSTACK; a = -1 marca o fim de segmento (EOS)
+    struct Triple {
+        int h, a, b;
+    };
+
+    // Quadro da busca em caminhos (pathSearch) na pilha explícita
+    struct Frame {
+        int v, slot, next, outv, edge, child;
+    };
+
+    int n;                  // Número de vértices
+    int realEdges;          // Arestas reais; ids >= realEdges são virtuais
+
+    vector<int> src, tgt;   // Extremos (orientados após a DFS) de cada aresta
+    vector<EdgeType> type;
+    vector<char> start;     // Aresta inicia um caminho na decomposição em caminhos
+    vector<int> inAdj;      // Posição da aresta na lista de adjacência
+    vector<int> inHigh;     // Posição da aresta na lista HIGHPT do destino
+
+    vector<int> number, newnum, nodeAt;
+    vector<int> lowpt1, lowpt2, nd, father, degree, treeArc;
+
+    ListPool adjacency;     // Estrutura de adjacência aceitável
+    ListPool highpt;        // Fronds de chegada em ordem de visita
+
+    vector<int> estack;
+    vector<Triple> tstack;
+    vector<Component> components;
+
+    int newEdge(int u, int v, EdgeType t);
+    int newComponent(CompType t);
+
+    void dfs1();
+    void buildAcceptableAdjStruct();
+    void pathFinder();
+    void pathSearch();
+    void afterChild(Frame& f);
+    void splitComponents();
+
+    int high(int v) const;
+    void delHigh(int e);
+    int firstChild(int v) const;
+    void pushTriple(int h, int a, int b);
+    bool tstackNotEOS() const;
+};
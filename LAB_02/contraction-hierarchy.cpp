@@ -0,0 +1,356 @@
+/**
+ * @file contraction-hierarchy.cpp
+ * @brief Implementação da classe ContractionHierarchy
+ * @date 2025-06-21
+ * @author pduartedev
+ */
+
+#include "contraction-hierarchy.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+
+using namespace std;
+
+const int ContractionHierarchy::UNREACHABLE = INT_MAX;
+
+// Distância interna para vértices ainda não alcançados
+static const int CH_INF = INT_MAX / 2;
+
+// Vértices fixados por busca de testemunha: com o limite a busca pode não
+// achar um caminho alternativo existente, o que só gera atalhos a mais. Para
+// estimar prioridades basta uma busca bem mais curta
+static const int WITNESS_SETTLE_LIMIT = 500;
+static const int ESTIMATE_SETTLE_LIMIT = 50;
+
+// Assinatura do arquivo gravado por save
+static const char CH_MAGIC[4] = {'G', 'B', 'C', 'H'};
+
+// Grafo restante durante a contração: listas de saída e de entrada apenas
+// entre vértices ainda não contraídos, com um único arco (o de menor peso) por par
+class ContractionState {
+public:
+    vector<vector<pair<int, int>>> out, in;
+    vector<char> contracted;
+    vector<int> deletedNeighbors;
+    vector<int> level;      // Altura na hierarquia já formada abaixo do vértice
+
+    explicit ContractionState(int n)
+        : out(n), in(n), contracted(n, false), deletedNeighbors(n, 0), level(n, 0),
+          witnessDist(n, CH_INF) {}
+
+    // Insere u -> x com peso w ou reduz o peso do arco existente
+    void addArc(int u, int x, int w) {
+        setMin(out[u], x, w);
+        setMin(in[x], u, w);
+    }
+
+    // Número de atalhos que a contração de v cria (e cria-os se apply)
+    int contract(int v, bool apply) {
+        int shortcuts = 0;
+        int maxOut = 0;
+        for (const auto& arc : out[v]) maxOut = max(maxOut, arc.second);
+
+        for (const auto& inArc : in[v]) {
+            int u = inArc.first;
+            witnessSearch(u, v, inArc.second + maxOut,
+                          apply ? WITNESS_SETTLE_LIMIT : ESTIMATE_SETTLE_LIMIT);
+            for (const auto& outArc : out[v]) {
+                int x = outArc.first;
+                if (x == u) continue;
+                int through = inArc.second + outArc.second;
+                if (witnessDist[x] > through) {
+                    shortcuts++;
+                    if (apply) addArc(u, x, through);
+                }
+            }
+            for (int y : witnessTouched) witnessDist[y] = CH_INF;
+            witnessTouched.clear();
+        }
+        return shortcuts;
+    }
+
+    // Diferença de arestas mais vizinhos já contraídos e altura (menor =
+    // contrai antes); os dois últimos termos espalham a contração pelo grafo
+    int priority(int v) {
+        return contract(v, false) - (int)in[v].size() - (int)out[v].size() +
+               deletedNeighbors[v] + level[v];
+    }
+
+    // Retira v do grafo restante
+    void remove(int v) {
+        contracted[v] = true;
+        for (const auto& arc : out[v]) {
+            erase(in[arc.first], v);
+            deletedNeighbors[arc.first]++;
+            level[arc.first] = max(level[arc.first], level[v] + 1);
+        }
+        for (const auto& arc : in[v]) {
+            erase(out[arc.first], v);
+            deletedNeighbors[arc.first]++;
+            level[arc.first] = max(level[arc.first], level[v] + 1);
+        }
+    }
+
+private:
+    vector<int> witnessDist;
+    vector<int> witnessTouched;
+    IndexedDaryHeap<4> heap;
+
+    static void setMin(vector<pair<int, int>>& arcs, int x, int w) {
+        for (auto& arc : arcs) {
+            if (arc.first == x) {
+                arc.second = min(arc.second, w);
+                return;
+            }
+        }
+        arcs.emplace_back(x, w);
+    }
+
+    static void erase(vector<pair<int, int>>& arcs, int x) {
+        for (size_t i = 0; i < arcs.size(); i++) {
+            if (arcs[i].first == x) {
+                arcs[i] = arcs.back();
+                arcs.pop_back();
+                return;
+            }
+        }
+    }
+
+    // Dijkstra a partir de source sem passar por skip, até a distância limit ou
+    // até fixar settleLimit vértices
+    void witnessSearch(int source, int skip, int limit, int settleLimit) {
+        heap.reset();
+        witnessDist[source] = 0;
+        witnessTouched.push_back(source);
+        heap.push(0, source);
+
+        int settled = 0;
+        while (!heap.empty() && settled < settleLimit) {
+            pair<unsigned int, int> top = heap.pop();
+            int y = top.second;
+            if ((int)top.first > limit) break;
+            settled++;
+
+            for (const auto& arc : out[y]) {
+                int z = arc.first;
+                if (z == skip) continue;
+                int candidate = witnessDist[y] + arc.second;
+                if (candidate < witnessDist[z]) {
+                    if (witnessDist[z] == CH_INF) witnessTouched.push_back(z);
+                    witnessDist[z] = candidate;
+                    heap.push((unsigned int)candidate, z);
+                }
+            }
+        }
+    }
+};
+
+ContractionHierarchy::ContractionHierarchy() : n(0) {
+    prepareQueries();
+}
+
+ContractionHierarchy::ContractionHierarchy(int n, const vector<Arc>& arcs,
+                                           const vector<int>& potentials)
+    : n(n), potentials(potentials) {
+    ContractionState state(n);
+    for (const auto& arc : arcs) {
+        if (arc.source != arc.target) state.addArc(arc.source, arc.target, arc.weight);
+    }
+
+    // Ordem de contração com atualização preguiçosa das prioridades: o vértice
+    // retirado da fila só é contraído se a prioridade recalculada ainda for a menor
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> order;
+    for (int v = 0; v < n; v++) {
+        order.push({state.priority(v), v});
+    }
+
+    vector<vector<pair<int, int>>> up(n), down(n);
+    while (!order.empty()) {
+        int v = order.top().second;
+        order.pop();
+        if (state.contracted[v]) continue;
+
+        int current = state.priority(v);
+        if (!order.empty() && current > order.top().first) {
+            order.push({current, v});
+            continue;
+        }
+
+        // Os arcos restantes de v levam a vértices contraídos depois (acima de v)
+        state.contract(v, true);
+        up[v] = state.out[v];
+        down[v] = state.in[v];
+        state.remove(v);
+    }
+
+    upStart.assign(n + 1, 0);
+    downStart.assign(n + 1, 0);
+    for (int v = 0; v < n; v++) {
+        upStart[v + 1] = upStart[v] + (int)up[v].size();
+        downStart[v + 1] = downStart[v] + (int)down[v].size();
+        for (const auto& arc : up[v]) {
+            upTargets.push_back(arc.first);
+            upWeights.push_back(arc.second);
+        }
+        for (const auto& arc : down[v]) {
+            downSources.push_back(arc.first);
+            downWeights.push_back(arc.second);
+        }
+    }
+    prepareQueries();
+}
+
+// Formato: assinatura, n, número de arcos para cima e para baixo, potenciais
+// e os vetores CSR, todos int32 na ordem de bytes nativa
+ContractionHierarchy::ContractionHierarchy(const string& path) : n(0) {
+    ifstream file(path, ios::binary);
+    char magic[4];
+    if (!file.read(magic, sizeof(magic)) || memcmp(magic, CH_MAGIC, sizeof(magic)) != 0) {
+        throw runtime_error("arquivo de hierarquia inválido: " + path);
+    }
+
+    // Contagens negativas ou maiores que o arquivo são recusadas antes de
+    // qualquer alocação
+    int header[3];
+    file.read((char*)header, sizeof(header));
+    streamoff headerEnd = file.tellg();
+    file.seekg(0, ios::end);
+    long long remaining = (long long)(file.tellg() - headerEnd) / (long long)sizeof(int);
+    file.seekg(headerEnd);
+    if (!file || header[0] < 0 || header[1] < 0 || header[2] < 0 ||
+        3LL * header[0] + 2 + 2LL * header[1] + 2LL * header[2] > remaining) {
+        throw runtime_error("arquivo de hierarquia inválido: " + path);
+    }
+    n = header[0];
+    auto readInts = [&](vector<int>& values, int count) {
+        values.resize(count);
+        file.read((char*)values.data(), (streamsize)count * sizeof(int));
+    };
+    readInts(potentials, n);
+    readInts(upStart, n + 1);
+    readInts(upTargets, header[1]);
+    readInts(upWeights, header[1]);
+    readInts(downStart, n + 1);
+    readInts(downSources, header[2]);
+    readInts(downWeights, header[2]);
+    if (!file) {
+        throw runtime_error("arquivo de hierarquia incompleto: " + path);
+    }
+    
+    // Cada CSR deve começar em 0, não decrescer, terminar na contagem do
+    // cabeçalho e apontar só para vértices em [0, n)
+    auto validCsr = [&](const vector<int>& start, const vector<int>& ends, int count) {
+        if (start[0] != 0 || start[n] != count) return false;
+        for (int v = 0; v < n; v++) {
+            if (start[v] > start[v + 1]) return false;
+        }
+        for (int w : ends) {
+            if (w < 0 || w >= n) return false;
+        }
+        return true;
+    };
+    if (!validCsr(upStart, upTargets, header[1]) || !validCsr(downStart, downSources, header[2])) {
+        throw runtime_error("arquivo de hierarquia inválido: " + path);
+    }
+    prepareQueries();
+}
+
+void ContractionHierarchy::save(const string& path) const {
+    ofstream file(path, ios::binary | ios::trunc);
+    int header[3] = {n, (int)upTargets.size(), (int)downSources.size()};
+    file.write(CH_MAGIC, sizeof(CH_MAGIC));
+    file.write((const char*)header, sizeof(header));
+    for (const vector<int>* values : {&potentials, &upStart, &upTargets, &upWeights,
+                                      &downStart, &downSources, &downWeights}) {
+        file.write((const char*)values->data(), (streamsize)values->size() * sizeof(int));
+    }
+    if (!file) {
+        throw runtime_error("não foi possível gravar " + path);
+    }
+}
+
+void ContractionHierarchy::prepareQueries() {
+    forwardDist.assign(n, CH_INF);
+    backwardDist.assign(n, CH_INF);
+}
+
+int ContractionHierarchy::distance(int s, int t) {
+    if (s == t) return 0;
+
+    // Cada busca só sobe e continua enquanto a sua menor chave ainda pode
+    // melhorar best; o encontro no vértice mais alto do caminho mínimo é
+    // visto pelas duas
+    long long best = CH_INF;
+    forward.reset();
+    backward.reset();
+    forwardDist[s] = 0;
+    backwardDist[t] = 0;
+    touched.push_back(s);
+    touched.push_back(t);
+    forward.push(0, s);
+    backward.push(0, t);
+
+    while (!forward.empty() || !backward.empty()) {
+        bool isForward;
+        if (forward.empty()) {
+            isForward = false;
+        } else if (backward.empty()) {
+            isForward = true;
+        } else {
+            isForward = forward.top().first <= backward.top().first;
+        }
+
+        IndexedDaryHeap<4>& pq = isForward ? forward : backward;
+        if ((long long)pq.top().first >= best) {
+            pq.reset();
+            continue;
+        }
+
+        vector<int>& dist = isForward ? forwardDist : backwardDist;
+        const vector<int>& other = isForward ? backwardDist : forwardDist;
+        const vector<int>& start = isForward ? upStart : downStart;
+        const vector<int>& heads = isForward ? upTargets : downSources;
+        const vector<int>& weights = isForward ? upWeights : downWeights;
+
+        int x = pq.pop().second;
+        if (other[x] != CH_INF) {
+            best = min(best, (long long)dist[x] + other[x]);
+        }
+
+        // Stall-on-demand: se um vértice acima de x chega a x por menos que
+        // dist[x], nenhum caminho mínimo sobe por x nesta busca
+        const vector<int>& stallStart = isForward ? downStart : upStart;
+        const vector<int>& stallHeads = isForward ? downSources : upTargets;
+        const vector<int>& stallWeights = isForward ? downWeights : upWeights;
+        bool stalled = false;
+        for (int k = stallStart[x]; k < stallStart[x + 1] && !stalled; k++) {
+            int y = stallHeads[k];
+            stalled = dist[y] != CH_INF && dist[y] + stallWeights[k] < dist[x];
+        }
+        if (stalled) continue;
+
+        for (int k = start[x]; k < start[x + 1]; k++) {
+            int y = heads[k];
+            int candidate = dist[x] + weights[k];
+            if (candidate < dist[y]) {
+                if (forwardDist[y] == CH_INF && backwardDist[y] == CH_INF) touched.push_back(y);
+                dist[y] = candidate;
+                pq.push((unsigned int)candidate, y);
+            }
+        }
+    }
+
+    for (int x : touched) {
+        forwardDist[x] = CH_INF;
+        backwardDist[x] = CH_INF;
+    }
+    touched.clear();
+
+    if (best >= CH_INF) return UNREACHABLE;
+    return (int)(best - potentials[s] + potentials[t]);
+}
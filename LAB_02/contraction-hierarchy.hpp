@@ -0,0 +1,73 @@
+/**
+ * @file contraction-hierarchy.hpp
+ * @brief Declaração da classe ContractionHierarchy para consultas ponto a ponto
+ * @details Os vértices são contraídos um a um (menor diferença de arestas
+ *          primeiro); ao contrair v, cada caminho u -> v -> x sem caminho
+ *          alternativo de mesmo custo vira um atalho u -> x. Sobram apenas os
+ *          arcos "para cima" (para vértices contraídos depois), e uma consulta
+ *          é um Dijkstra bidirecional que só sobe na hierarquia, visitando
+ *          poucas centenas de vértices mesmo em grafos grandes. Os pesos são
+ *          os reponderados por Johnson (não negativos); os potenciais vão
+ *          junto para devolver as distâncias originais.
+ * @date 2025-06-21
+ * @author pduartedev
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "indexed-heap.hpp"
+
+using namespace std;
+
+class ContractionHierarchy {
+public:
+    // Arco com peso já reponderado (não negativo)
+    struct Arc {
+        int source, target, weight;
+    };
+
+    // Hierarquia vazia
+    ContractionHierarchy();
+
+    // Pré-processa o grafo de n vértices com arcos reponderados pelos potenciais
+    ContractionHierarchy(int n, const vector<Arc>& arcs, const vector<int>& potentials);
+
+    // Carrega uma hierarquia gravada por save; lança runtime_error se falhar
+    // ou se o cabeçalho e os vetores CSR forem inconsistentes
+    explicit ContractionHierarchy(const string& path);
+
+    // Grava a hierarquia em formato binário; lança runtime_error se falhar
+    void save(const string& path) const;
+
+    int size() const { return n; }
+
+    // Número de arcos para cima (originais e atalhos) nos dois sentidos
+    size_t arcCount() const { return upTargets.size() + downSources.size(); }
+
+    // Distância original de s a t (UNREACHABLE se não houver caminho)
+    // Usa memória de trabalho interna, então não pode ser chamada em paralelo
+    // no mesmo objeto
+    int distance(int s, int t);
+
+    // Valor devolvido por distance para pares sem caminho
+    static const int UNREACHABLE;
+
+private:
+    int n;
+    vector<int> potentials;
+
+    // Arcos para cima em formato CSR: upTargets[upStart[v]..upStart[v + 1])
+    // são os arcos v -> x e downSources os arcos x -> v, sempre com x acima de v
+    vector<int> upStart, upTargets, upWeights;
+    vector<int> downStart, downSources, downWeights;
+
+    // Memória das consultas: distâncias voltam a INF ao fim de cada uma
+    vector<int> forwardDist, backwardDist;
+    vector<int> touched;
+    IndexedDaryHeap<4> forward, backward;
+
+    void prepareQueries();
+};
@@ -13,6 +13,12 @@
 #include <string>
 #include <queue>
 #include <utility> // for std::pair
+#include <list>
+#include <unordered_map>
+#include "distance-matrix.hpp"
+#include "predecessor-matrix.hpp"
+#include "contraction-hierarchy.hpp"
+#include "dijkstra-queues.hpp"
 
 using namespace std;
 
@@ -28,12 +34,76 @@ private:
     };
     vector<Edge> edgeList;
 
+    // Potenciais de Johnson e matriz de distâncias mantidos entre chamadas;
+    // addEdge os invalida e updateEdge os atualiza de forma incremental
+    vector<int> potentials;
+    bool potentialsValid;
+    DistanceMatrix cachedDistances;
+    bool distancesValid;
+
+    // Calcula os potenciais (Bellman-Ford a partir de um super vértice)
+    // Retorna false se houver ciclo negativo
+    bool computePotentials();
+
+    // Caminho mínimo from -> to (inclusive) seguindo arcos justos da matriz em cache
+    vector<int> shortestPathFromCache(int from, int to) const;
+
+    // Consultas sob demanda: arcos reversos (montados na primeira consulta),
+    // linhas de distâncias em um cache LRU e memória de trabalho do Dijkstra
+    // bidirecional, cujas distâncias voltam a INF ao fim de cada consulta
+    vector<vector<pair<int, int>>> reverseAdjList;
+    bool reverseValid;
+    size_t rowCacheCapacity;
+    list<int> rowOrder;     // Linhas em cache, da mais para a menos recente
+    unordered_map<int, pair<vector<int>, list<int>::iterator>> rowCache;
+    vector<int> forwardDist, backwardDist;
+
+    // Descarta o que depende dos arcos (chamado quando o grafo muda)
+    void invalidateQueries();
+    
+    // updateEdge sem matriz válida: aplica a alteração a uma cópia e a efetiva
+    // se a cópia não tiver ciclo negativo
+    bool updateEdgeFromScratch(int u, int v, int w, vector<int>& cycle);
+
+    // Garante potenciais válidos; lança runtime_error se houver ciclo negativo
+    void requirePotentials();
+
+    // Bellman-Ford com fila de trabalho (SPFA) e desmontagem de subárvores (Tarjan):
+    // só vértices cuja distância mudou são reprocessados e, ao melhorar v, a
+    // subárvore de v na árvore de caminhos é descartada; se ela contém a origem
+    // da aresta relaxada, há um ciclo negativo.
+    // dist chega inicializado (INF fora das raízes) e parent recebe a árvore.
+    // Retorna -1 se as distâncias convergiram ou um vértice de um ciclo negativo,
+    // que pode ser percorrido por parent.
+    // Com cycles, cada ciclo encontrado é guardado e os seus vértices saem do
+    // grafo; o restante da subárvore volta para a raiz virtual e a mesma
+    // passada continua até convergir (retornando -1)
+    int relaxWorkList(vector<int>& dist, vector<int>& parent,
+                      vector<vector<int>>* cycles = nullptr) const;
+
     // Executa o algoritmo de Bellman-Ford a partir de um vértice fonte
     // Retorna um vetor de potenciais para reponderar o grafo
     vector<int> bellmanFord(int source);
 
     // Executa o algoritmo de Dijkstra a partir de um vértice fonte com pesos reponderados
-    vector<int> dijkstra(int source, const vector<int>& h);
+    // As distâncias são escritas em dist (tamanho n) e a fila é reaproveitada
+    // entre chamadas, de modo que cada thread usa apenas a sua memória
+    // Queue é uma das políticas de dijkstra-queues.hpp; maxStep é o maior peso
+    // reponderado (usado pela fila de Dial). Com parent, recebe também a árvore
+    // de caminhos (-1 na origem e nos vértices não alcançados)
+    template <typename Queue>
+    void dijkstra(int source, const vector<int>& h, vector<int>& dist, Queue& pq,
+                  unsigned int maxStep, vector<int>* parent = nullptr) const;
+
+    // Floyd-Warshall em blocos sobre uma matriz int32 contígua (linhas de
+    // tamanho múltiplo do bloco), copiada ao final para result; exige que não
+    // haja ciclos negativos
+    void floydWarshall(DistanceMatrix& result, int threads) const;
+
+    // Preenche os predecessores a partir de uma matriz de distâncias pronta:
+    // para cada origem, busca em largura pelos arcos justos (O(m) por linha)
+    void predecessorsFromDistances(const DistanceMatrix& dist, PredecessorMatrix& predecessors,
+                                   int threads) const;
 
 public:
     // Construtor
@@ -45,9 +115,68 @@ public:
     // Verifica se há ciclo negativo e retorna o ciclo caso exista
     bool hasNegativeCycle(vector<int>& cycle);
     
+    // Ciclos negativos disjuntos em vértices, encontrados em uma única passada;
+    // o conjunto é maximal: sem os seus vértices não resta ciclo negativo.
+    // Cada ciclo vem na ordem dos arcos, sem repetir o primeiro vértice
+    vector<vector<int>> negativeCycles() const;
+    
     // Calcula caminhos mínimos entre todos os pares de vértices usando o algoritmo de Johnson
-    vector<vector<int>> allPairsShortestPaths();
+    // As fontes do Dijkstra são divididas entre threads (0 = todos os núcleos)
+    // Grafos densos (m / n² >= denseThreshold(n)) usam o Floyd-Warshall em blocos
+    // A matriz usa int16 quando os pesos permitem; com spillPath ela é mapeada
+    // nesse arquivo em vez de ficar na memória. Retorna vazia com ciclo negativo.
+    // Queue escolhe a fila do Dijkstra (RadixHeap, DialQueue ou BinaryHeapQueue)
+    // Com predecessors, grava também a matriz de predecessores dos caminhos,
+    // da qual reconstructPath extrai qualquer caminho sem nova busca
+    template <typename Queue = RadixHeap>
+    DistanceMatrix allPairsShortestPaths(int threads = 0, const string& spillPath = "",
+                                         PredecessorMatrix* predecessors = nullptr);
+    
+    // Matriz de distâncias mantida pelo grafo (calculada na primeira chamada e
+    // depois atualizada por updateEdge); vazia se houver ciclo negativo
+    const DistanceMatrix& distances();
+    
+    // Define o peso do arco u -> v (inserindo-o se não existir) e atualiza a
+    // matriz em cache: inserções e reduções de peso custam O(n²) e aumentos
+    // invalidam a matriz, recalculada na próxima consulta.
+    // Se o grafo resultante tiver um ciclo negativo, a alteração não é aplicada:
+    // retorna false e o ciclo em cycle (primeiro vértice repetido no final).
+    // Se o grafo atual já tiver ciclo negativo (sem matriz), a alteração é
+    // testada do zero em uma cópia e aplicada se remover todos os ciclos
+    bool updateEdge(int u, int v, int w, vector<int>& cycle);
+    
+    // Distância de u a v sem calcular a matriz: Dijkstra bidirecional sobre os
+    // pesos reponderados pelos potenciais (calculados uma vez e reaproveitados),
+    // ou consulta direta se a linha u estiver em cache. UNREACHABLE se não há
+    // caminho; lança runtime_error se o grafo tiver ciclo negativo
+    int distance(int u, int v);
+    
+    // Linha u da matriz (distâncias a partir de u), guardada no cache LRU
+    // A referência vale até a próxima consulta ou alteração do grafo
+    const vector<int>& distancesFrom(int u);
+    
+    // Número máximo de linhas no cache LRU (padrão: 64)
+    void setRowCacheCapacity(size_t rows);
+    
+    // Hierarquia de contração sobre os pesos reponderados pelos potenciais,
+    // para muitas consultas ponto a ponto na mesma topologia (pode ser gravada
+    // com save); lança runtime_error se o grafo tiver ciclo negativo
+    ContractionHierarchy contractionHierarchy();
+    
+    // Densidade m / n² a partir da qual o Floyd-Warshall (c·n³) supera as n
+    // execuções do Dijkstra (n·log n·(a·m + b·n)); cresce até n ≈ 10⁴ e depois
+    // cai como 1 / log n. Nunca abaixo de DENSE_THRESHOLD_MIN
+    static double denseThreshold(int n);
+    static constexpr double DENSE_THRESHOLD_MIN = 0.006;
     
     // Imprime a matriz de distâncias conforme o formato especificado
-    void printDistanceMatrix(const vector<vector<int>>& distances);
+    // (linhas montadas em um buffer grande e enviadas em poucas escritas)
+    void printDistanceMatrix(const DistanceMatrix& distances);
+    
+    // Grava a matriz em binário: assinatura FAST_INPUT_MAGIC, n e os n² valores
+    // int32 em ordem de linhas, com UNREACHABLE nas posições sem caminho
+    void writeDistanceMatrixBinary(const DistanceMatrix& distances);
+    
+    // Valor gravado no formato binário para pares sem caminho
+    static const int UNREACHABLE = DistanceMatrix::UNREACHABLE;
 };
\ No newline at end of file
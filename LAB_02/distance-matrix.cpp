@@ -0,0 +1,143 @@
+/**
+ * @file distance-matrix.cpp
+ * @brief Implementação da classe DistanceMatrix
+ * @date 2025-06-21
+ * @author pduartedev
+ */
+
+#include "distance-matrix.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Alinhamento do buffer e das linhas (uma linha de cache)
+static const size_t MATRIX_ALIGNMENT = 64;
+
+const int DistanceMatrix::UNREACHABLE;
+const int16_t DistanceMatrix::UNREACHABLE16;
+
+DistanceMatrix::DistanceMatrix()
+    : n(0), type(INT32), rowStride(0), bytes(0), data(nullptr), fileBacked(false) {}
+
+DistanceMatrix::DistanceMatrix(int n, Storage storage, const string& path)
+    : n(n), type(storage), data(nullptr), fileBacked(!path.empty()) {
+    size_t element = (type == INT16) ? sizeof(int16_t) : sizeof(int32_t);
+    size_t perLine = MATRIX_ALIGNMENT / element;
+    rowStride = ((size_t)n + perLine - 1) / perLine * perLine;
+    bytes = max(rowStride * n * element, MATRIX_ALIGNMENT);
+
+    if (fileBacked) {
+        int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw runtime_error("não foi possível criar o arquivo " + path);
+        }
+        if (ftruncate(fd, (off_t)bytes) != 0) {
+            close(fd);
+            throw runtime_error("não foi possível reservar " + path);
+        }
+        data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            data = nullptr;
+            throw runtime_error("não foi possível mapear " + path);
+        }
+    } else if (posix_memalign(&data, MATRIX_ALIGNMENT, bytes) != 0) {
+        data = nullptr;
+        throw bad_alloc();
+    }
+
+    // Todas as posições começam sem caminho
+    if (type == INT16) {
+        fill((int16_t*)data, (int16_t*)data + rowStride * n, UNREACHABLE16);
+    } else {
+        fill((int32_t*)data, (int32_t*)data + rowStride * n, (int32_t)UNREACHABLE);
+    }
+}
+
+DistanceMatrix::~DistanceMatrix() {
+    release();
+}
+
+DistanceMatrix::DistanceMatrix(DistanceMatrix&& other)
+    : n(other.n), type(other.type), rowStride(other.rowStride), bytes(other.bytes),
+      data(other.data), fileBacked(other.fileBacked) {
+    other.n = 0;
+    other.data = nullptr;
+}
+
+DistanceMatrix& DistanceMatrix::operator=(DistanceMatrix&& other) {
+    if (this != &other) {
+        release();
+        n = other.n;
+        type = other.type;
+        rowStride = other.rowStride;
+        bytes = other.bytes;
+        data = other.data;
+        fileBacked = other.fileBacked;
+        other.n = 0;
+        other.data = nullptr;
+    }
+    return *this;
+}
+
+void DistanceMatrix::release() {
+    if (!data) return;
+    if (fileBacked) {
+        munmap(data, bytes);
+    } else {
+        free(data);
+    }
+    data = nullptr;
+}
+
+DistanceMatrix::Storage DistanceMatrix::storageFor(int n, long long maxAbsWeight) {
+    // Um caminho mínimo sem ciclos negativos tem no máximo n - 1 arestas
+    long long bound = (long long)max(n - 1, 0) * maxAbsWeight;
+    return (bound < UNREACHABLE16) ? INT16 : INT32;
+}
+
+void DistanceMatrix::storeRow(int i, const int* values) {
+    if (type == INT16) {
+        int16_t* row = (int16_t*)data + (size_t)i * rowStride;
+        for (int j = 0; j < n; j++) {
+            row[j] = (values[j] == UNREACHABLE) ? UNREACHABLE16 : (int16_t)values[j];
+        }
+    } else {
+        memcpy((int32_t*)data + (size_t)i * rowStride, values, (size_t)n * sizeof(int32_t));
+    }
+}
+
+// Relaxa todos os pares pelo arco u -> v sobre linhas do tipo T. Sem ciclo
+// negativo a linha v e a coluna u não mudam, então a atualização é feita no
+// próprio buffer (a linha v é copiada apenas para ficar contígua em cache)
+template <typename T>
+static void relaxRows(T* data, size_t stride, int n, int u, int v, int w, T unreachable) {
+    vector<T> rowV(data + (size_t)v * stride, data + (size_t)v * stride + n);
+    for (int i = 0; i < n; i++) {
+        T* row = data + (size_t)i * stride;
+        if (row[u] == unreachable) continue;
+
+        int base = row[u] + w;
+        for (int j = 0; j < n; j++) {
+            if (rowV[j] == unreachable) continue;
+            int candidate = base + rowV[j];
+            if (candidate < row[j]) row[j] = (T)candidate;
+        }
+    }
+}
+
+void DistanceMatrix::relaxThrough(int u, int v, int w) {
+    if (type == INT16) {
+        relaxRows((int16_t*)data, rowStride, n, u, v, w, UNREACHABLE16);
+    } else {
+        relaxRows((int32_t*)data, rowStride, n, u, v, w, (int32_t)UNREACHABLE);
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ * @file distance-matrix.hpp
+ * @brief Declaração da classe DistanceMatrix para resultados de caminhos mínimos
+ * @details A matriz ocupa um único buffer alinhado, com linhas de tamanho
+ *          múltiplo de 64 bytes, e guarda as distâncias em int16 ou int32
+ *          conforme os limites dos pesos. O buffer pode ficar em memória ou
+ *          ser mapeado em um arquivo (mmap) para matrizes grandes demais.
+ * @date 2025-06-21
+ * @author pduartedev
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+using namespace std;
+
+class DistanceMatrix {
+public:
+    // Tipo dos elementos armazenados
+    enum Storage { INT16, INT32 };
+
+    // Valor devolvido por get() para pares sem caminho
+    static const int UNREACHABLE = numeric_limits<int>::max();
+
+    // Valor int16 que representa a ausência de caminho
+    static const int16_t UNREACHABLE16 = numeric_limits<int16_t>::max();
+
+    // Matriz vazia (usada quando não há resultado, p. ex. com ciclo negativo)
+    DistanceMatrix();
+
+    // Matriz n x n sem caminhos; se path não for vazio, o buffer é um arquivo mapeado
+    DistanceMatrix(int n, Storage storage, const string& path = "");
+
+    ~DistanceMatrix();
+
+    DistanceMatrix(DistanceMatrix&& other);
+    DistanceMatrix& operator=(DistanceMatrix&& other);
+    DistanceMatrix(const DistanceMatrix&) = delete;
+    DistanceMatrix& operator=(const DistanceMatrix&) = delete;
+
+    // Menor tipo capaz de representar distâncias de caminhos simples com n
+    // vértices e pesos de valor absoluto até maxAbsWeight
+    static Storage storageFor(int n, long long maxAbsWeight);
+
+    int size() const { return n; }
+    bool empty() const { return n == 0; }
+    Storage storage() const { return type; }
+
+    // Elementos por linha no buffer (n arredondado para 64 bytes)
+    size_t stride() const { return rowStride; }
+
+    // Distância de i a j (UNREACHABLE se não houver caminho)
+    int get(int i, int j) const {
+        if (type == INT16) {
+            int16_t value = row16(i)[j];
+            return value == UNREACHABLE16 ? UNREACHABLE : value;
+        }
+        return row32(i)[j];
+    }
+
+    // Grava a linha i a partir de n valores int32 (UNREACHABLE para sem caminho)
+    void storeRow(int i, const int* values);
+
+    // Incorpora um arco u -> v de peso w: d[i][j] = min(d[i][j], d[i][u] + w + d[v][j])
+    // em O(n²); exige que o arco não feche um ciclo negativo (d[v][u] + w >= 0)
+    void relaxThrough(int u, int v, int w);
+
+    // Acesso direto às linhas conforme o tipo armazenado
+    const int16_t* row16(int i) const { return (const int16_t*)data + (size_t)i * rowStride; }
+    const int32_t* row32(int i) const { return (const int32_t*)data + (size_t)i * rowStride; }
+
+    // Visão de uma linha, para a sintaxe distances[i][j]
+    class RowView {
+    public:
+        RowView(const DistanceMatrix& matrix, int i) : matrix(matrix), i(i) {}
+        int operator[](int j) const { return matrix.get(i, j); }
+        int size() const { return matrix.size(); }
+
+    private:
+        const DistanceMatrix& matrix;
+        int i;
+    };
+
+    RowView operator[](int i) const { return RowView(*this, i); }
+
+private:
+    int n;
+    Storage type;
+    size_t rowStride;
+    size_t bytes;
+    void* data;
+    bool fileBacked;
+
+    void release();
+};
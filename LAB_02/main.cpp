@@ -10,25 +10,67 @@
 
 #include <iostream>
 #include "directed-graph.hpp"
+#include "fast-input.hpp"
 
 using namespace std;
 
-int main() {
-    int n, m;
-    cin >> n >> m;
+int main(int argc, char* argv[]) {
+    ios_base::sync_with_stdio(false);
+    
+    // Leitura do cabeçalho (texto ou formato binário)
+    FastInput input;
+    int n = input.nextInt();
+    int m = input.nextInt();
     
     DirectedGraph graph(n);
     
     // Leitura do grafo
     for (int i = 0; i < m; i++) {
-        int u, v, c;
-        cin >> u >> v >> c;
+        int u = input.nextInt();
+        int v = input.nextInt();
+        int c = input.nextInt();
         graph.addEdge(u, v, c);
     }
     
+    // Opções: --binary (matriz int32 para outros programas), --spill <arquivo>
+    // (mantém a matriz em um arquivo mapeado), --all-cycles (relata todos os
+    // ciclos negativos disjuntos, cada um no formato de confere-ciclo-negativo)
+    // e --ch <arquivo> (grava a hierarquia de contração em vez da matriz)
+    bool binary = false;
+    bool allCycles = false;
+    string spillPath;
+    string hierarchyPath;
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        if (option == "--binary") {
+            binary = true;
+        } else if (option == "--all-cycles") {
+            allCycles = true;
+        } else if (option == "--spill" && i + 1 < argc) {
+            spillPath = argv[++i];
+        } else if (option == "--ch" && i + 1 < argc) {
+            hierarchyPath = argv[++i];
+        }
+    }
+    
     // Verifica se há ciclo negativo
     vector<int> cycle;
-    if (graph.hasNegativeCycle(cycle)) {
+    vector<vector<int>> cycles;
+    if (allCycles) {
+        cycles = graph.negativeCycles();
+    }
+    
+    if (!cycles.empty()) {
+        for (const auto& c : cycles) {
+            cout << "Ciclo negativo detectado" << '\n';
+            for (size_t i = 0; i < c.size(); i++) {
+                cout << c[i];
+                if (i < c.size() - 1)
+                    cout << " ";
+            }
+            cout << '\n';
+        }
+    } else if (!allCycles && graph.hasNegativeCycle(cycle)) {
         cout << "Ciclo negativo detectado" << endl;
         
         // Remove o último vértice que é igual ao primeiro (repetido)
@@ -41,12 +83,18 @@ int main() {
                 cout << " ";
         }
         cout << endl;
+    } else if (!hierarchyPath.empty()) {
+        graph.contractionHierarchy().save(hierarchyPath);
     } else {
         // Calcula os caminhos mínimos entre todos os pares de vértices
-        vector<vector<int>> distances = graph.allPairsShortestPaths();
+        DistanceMatrix distances = graph.allPairsShortestPaths(0, spillPath);
         
         // Imprime a matriz de distâncias
-        graph.printDistanceMatrix(distances);
+        if (binary) {
+            graph.writeDistanceMatrixBinary(distances);
+        } else {
+            graph.printDistanceMatrix(distances);
+        }
     }
     
     return 0;
@@ -0,0 +1,53 @@
+/**
+ * @file predecessor-matrix.cpp
+ * @brief Implementação da classe PredecessorMatrix
+ * @date 2025-06-21
+ * @author pduartedev
+ */
+
+#include "predecessor-matrix.hpp"
+#include <algorithm>
+
+using namespace std;
+
+const int PredecessorMatrix::NONE;
+const uint16_t PredecessorMatrix::NONE16;
+const uint32_t PredecessorMatrix::NONE32;
+
+PredecessorMatrix::PredecessorMatrix() : n(0), type(UINT32) {}
+
+PredecessorMatrix::PredecessorMatrix(int n)
+    : n(n), type(n < (int)NONE16 ? UINT16 : UINT32) {
+    if (type == UINT16) {
+        cells16.assign((size_t)n * n, NONE16);
+    } else {
+        cells32.assign((size_t)n * n, NONE32);
+    }
+}
+
+void PredecessorMatrix::storeRow(int i, const int* values) {
+    size_t base = (size_t)i * n;
+    if (type == UINT16) {
+        for (int j = 0; j < n; j++) {
+            cells16[base + j] = (values[j] == NONE) ? NONE16 : (uint16_t)values[j];
+        }
+    } else {
+        for (int j = 0; j < n; j++) {
+            cells32[base + j] = (values[j] == NONE) ? NONE32 : (uint32_t)values[j];
+        }
+    }
+}
+
+vector<int> PredecessorMatrix::reconstructPath(int u, int v) const {
+    vector<int> path;
+    if (u != v && get(u, v) == NONE) {
+        return path;
+    }
+    
+    for (int x = v; x != u; x = get(u, x)) {
+        path.push_back(x);
+    }
+    path.push_back(u);
+    reverse(path.begin(), path.end());
+    return path;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file predecessor-matrix.hpp
+ * @brief Declaração da classe PredecessorMatrix para reconstruir caminhos mínimos
+ * @details Guarda, para cada origem u, o predecessor de cada vértice v no
+ *          caminho mínimo de u até v (a árvore de caminhos de u). Os índices
+ *          ficam em uint16 quando n permite e em uint32 nos demais casos.
+ * @date 2025-06-21
+ * @author pduartedev
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+class PredecessorMatrix {
+public:
+    // Tipo dos elementos armazenados
+    enum Storage { UINT16, UINT32 };
+
+    // Predecessor de v quando v é a origem ou não há caminho
+    static const int NONE = -1;
+
+    // Matriz vazia
+    PredecessorMatrix();
+
+    // Matriz n x n sem predecessores, no menor tipo capaz de indexar n vértices
+    explicit PredecessorMatrix(int n);
+
+    int size() const { return n; }
+    bool empty() const { return n == 0; }
+    Storage storage() const { return type; }
+
+    // Predecessor de j no caminho mínimo a partir de i (NONE se não houver)
+    int get(int i, int j) const {
+        size_t k = (size_t)i * n + j;
+        if (type == UINT16) {
+            return cells16[k] == NONE16 ? NONE : cells16[k];
+        }
+        return cells32[k] == NONE32 ? NONE : (int)cells32[k];
+    }
+
+    // Grava a linha i a partir de n predecessores (NONE para origem e sem caminho)
+    void storeRow(int i, const int* values);
+
+    // Caminho mínimo de u até v (inclusive) em O(tamanho do caminho), seguindo
+    // os predecessores a partir de v; vazio se v não é alcançável a partir de u
+    vector<int> reconstructPath(int u, int v) const;
+
+private:
+    static const uint16_t NONE16 = UINT16_MAX;
+    static const uint32_t NONE32 = UINT32_MAX;
+
+    int n;
+    Storage type;
+    vector<uint16_t> cells16;
+    vector<uint32_t> cells32;
+};
@@ -0,0 +1,120 @@
+/**
+ * @file ch-load.cpp
+ * @brief Teste do carregamento de ContractionHierarchy com arquivos corrompidos
+ */
+
+#include "directed-graph.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool condition, const char* description) {
+    if (!condition) {
+        cerr << "FALHOU: " << description << endl;
+        failures++;
+    }
+}
+
+static vector<int> readFile(const string& path) {
+    ifstream file(path, ios::binary);
+    vector<char> bytes((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    vector<int> words(bytes.size() / sizeof(int));
+    memcpy(words.data(), bytes.data(), words.size() * sizeof(int));
+    return words;
+}
+
+static void writeFile(const string& path, const vector<int>& words) {
+    ofstream file(path, ios::binary | ios::trunc);
+    file.write((const char*)words.data(), (streamsize)words.size() * sizeof(int));
+}
+
+// Verdadeiro se o carregamento de words lança runtime_error
+static bool rejects(const string& path, const vector<int>& words) {
+    writeFile(path, words);
+    try {
+        ContractionHierarchy loaded(path);
+    } catch (const runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    // Ciclo 0 -> 1 -> 2 -> 3 -> 0 com uma corda 0 -> 2 e um arco negativo
+    DirectedGraph g(4);
+    g.addEdge(0, 1, 3);
+    g.addEdge(1, 2, -1);
+    g.addEdge(2, 3, 4);
+    g.addEdge(3, 0, 2);
+    g.addEdge(0, 2, 5);
+
+    const string path = "tests/ch-load.tmp";
+    ContractionHierarchy ch = g.contractionHierarchy();
+    ch.save(path);
+
+    // Cópia íntegra: mesmas distâncias
+    {
+        ContractionHierarchy loaded(path);
+        bool same = loaded.size() == 4;
+        for (int s = 0; same && s < 4; s++) {
+            for (int t = 0; t < 4; t++) {
+                same = same && loaded.distance(s, t) == ch.distance(s, t);
+            }
+        }
+        check(same, "hierarquia carregada responde como a original");
+    }
+
+    // Palavra 0 é a assinatura; 1..3 o cabeçalho (n e as contagens de arcos);
+    // seguem potentials (n), upStart (n + 1) e upTargets
+    vector<int> words = readFile(path);
+    int n = words[1];
+    int upStart = 4 + n;
+    int upTargets = upStart + n + 1;
+    int downStart = upTargets + 2 * words[2];
+
+    vector<int> bad = words;
+    bad[1] = -1;
+    check(rejects(path, bad), "n negativo");
+
+    bad = words;
+    bad[2] = -3;
+    check(rejects(path, bad), "contagem de arcos negativa");
+
+    bad = words;
+    bad[1] = 1 << 30;
+    check(rejects(path, bad), "n maior que o arquivo");
+
+    bad = words;
+    bad[upStart + n] += 1;
+    check(rejects(path, bad), "upStart[n] diferente da contagem");
+
+    bad = words;
+    bad[downStart + n] -= 1;
+    check(rejects(path, bad), "downStart[n] diferente da contagem");
+
+    if (words[2] > 0) {
+        bad = words;
+        bad[upTargets] = n;
+        check(rejects(path, bad), "alvo fora de [0, n)");
+    }
+
+    bad = words;
+    bad.resize(bad.size() - 1);
+    check(rejects(path, bad), "arquivo truncado");
+
+    remove(path.c_str());
+
+    if (failures == 0) {
+        cout << "ch-load: OK" << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file update-edge.cpp
+ * @brief Teste de DirectedGraph::updateEdge com ciclo negativo criado e removido
+ */
+
+#include "directed-graph.hpp"
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool condition, const char* description) {
+    if (!condition) {
+        cerr << "FALHOU: " << description << endl;
+        failures++;
+    }
+}
+
+int main() {
+    // 0 -> 1 -> 2 -> 0 e um arco independente 3 -> 4
+    DirectedGraph g(5);
+    g.addEdge(0, 1, 2);
+    g.addEdge(1, 2, 2);
+    g.addEdge(2, 0, 1);
+    g.addEdge(3, 4, 7);
+    vector<int> cycle;
+    
+    check(!g.distances().empty(), "grafo inicial sem ciclo negativo");
+    check(g.distances().get(0, 2) == 4, "d(0, 2) inicial");
+    
+    // Recusada: fecharia o ciclo 0 -> 1 -> 2 -> 0 com custo -1
+    check(!g.updateEdge(2, 0, -5, cycle), "alteração que cria ciclo é recusada");
+    check(cycle.size() == 4 && cycle.front() == cycle.back(), "ciclo devolvido fechado");
+    check(g.distances().get(2, 0) == 1, "peso recusado não é aplicado");
+    
+    // addEdge não verifica ciclos: a matriz fica vazia
+    g.addEdge(2, 0, -5);
+    check(g.distances().empty(), "ciclo negativo inserido por addEdge");
+    
+    // Alteração que mantém o ciclo continua recusada
+    check(!g.updateEdge(3, 4, 1, cycle), "alteração que mantém o ciclo é recusada");
+    check(!cycle.empty(), "ciclo devolvido com o grafo já cíclico");
+    
+    // O arco 2 -> 0 (os dois paralelos) volta a peso positivo: sem ciclo
+    check(g.updateEdge(2, 0, 3, cycle), "alteração que remove o ciclo é aplicada");
+    check(!g.distances().empty(), "matriz recalculada após remover o ciclo");
+    check(g.distances().get(2, 1) == 5, "d(2, 1) após remover o ciclo");
+    
+    // Com a matriz válida, alterações independentes voltam a ser incrementais
+    check(g.updateEdge(3, 4, 1, cycle), "alteração em arco independente");
+    check(g.distances().get(3, 4) == 1, "d(3, 4) atualizado");
+    check(g.updateEdge(4, 0, 2, cycle), "inserção de arco");
+    check(g.distances().get(3, 2) == 7, "d(3, 2) pelo arco inserido");
+    
+    if (failures == 0) {
+        cout << "update-edge: OK" << endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
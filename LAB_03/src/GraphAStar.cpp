@@ -2,7 +2,8 @@
 #include <iostream>
 #include <algorithm>
 
-GraphAStar::GraphAStar() : statesEvaluated(0), statesEnqueued(0) {}
+GraphAStar::GraphAStar()
+    : tables(nullptr), walking(nullptr), statesEvaluated(0), statesEnqueued(0) {}
 
 vector<GraphNode> GraphAStar::solve(const GraphNode& initial) {
     auto startTime = chrono::high_resolution_clock::now();
@@ -31,13 +32,15 @@ vector<GraphNode> GraphAStar::solve(const GraphNode& initial) {
     priority_queue<AStarNode, vector<AStarNode>, greater<AStarNode>> openSet;
     
     // Conjuntos para controle de estados
-    unordered_set<string> closedSet;
-    unordered_set<string> inOpenSet;
-    unordered_map<string, AStarNode> allNodes; // Para reconstruir o caminho
+    unordered_set<uint64_t> closedSet;
+    unordered_set<uint64_t> inOpenSet;
+    unordered_map<uint64_t, AStarNode> allNodes; // Para reconstruir o caminho
     
     // Adiciona o estado inicial
-    int initialH = calculateHeuristic(initial);
-    AStarNode initialNode(initial, 0, initialH);
+    prepareTables(initial.getSize());
+    HeuristicState initialComponents = initialHeuristic(initial);
+    int initialH = heuristicValue(initialComponents);
+    AStarNode initialNode(initial, 0, initialComponents, initialH);
     
     openSet.push(initialNode);
     inOpenSet.insert(initial.getId());
@@ -45,9 +48,9 @@ vector<GraphNode> GraphAStar::solve(const GraphNode& initial) {
     statesEnqueued++;
     
     cout << "=== Iniciando busca A* no grafo de estados ===" << endl;
-    cout << "Estado inicial (Vértice): " << initial.getId() << endl;
+    cout << "Estado inicial (Vértice): " << initial.getLabel() << endl;
     cout << "Heurística inicial (Manhattan): " << initial.calculateManhattanDistance() << endl;
-    cout << "Heurística avançada (Manhattan + Linear Conflicts): " << initialH << endl;
+    cout << "Heurística avançada (Manhattan + Linear Conflicts / Walking Distance): " << initialH << endl;
     cout << "Instância solucionável: " << (initial.isSolvable() ? "SIM" : "NÃO") << endl << endl;
     
     const int MAX_STATES = (initial.getSize() == 3) ? 500000 : 5000000; // 5M para 15-puzzle, 500k para 8-puzzle
@@ -79,7 +82,7 @@ vector<GraphNode> GraphAStar::solve(const GraphNode& initial) {
             executionTime = endTime - startTime;
             
             cout << "=== Solução encontrada! ===" << endl;
-            cout << "Vértice objetivo: " << current.graphNode.getId() << endl;
+            cout << "Vértice objetivo: " << current.graphNode.getLabel() << endl;
             cout << "Custo da solução: " << current.gCost << endl;
             
             return reconstructPath(current, allNodes);
@@ -98,7 +101,8 @@ vector<GraphNode> GraphAStar::solve(const GraphNode& initial) {
             }
             
             int tentativeG = current.gCost + 1; // Custo da aresta é sempre 1
-            int h = calculateHeuristic(neighbor);
+            HeuristicState components = childHeuristic(current.components, current.graphNode, neighbor);
+            int h = heuristicValue(components);
             
             // Se não está na lista aberta ou encontramos um caminho melhor
             bool inOpen = inOpenSet.find(neighbor.getId()) != inOpenSet.end();
@@ -113,7 +117,7 @@ vector<GraphNode> GraphAStar::solve(const GraphNode& initial) {
             }
             
             if (!inOpen || betterPath) {
-                AStarNode neighborNode(neighbor, tentativeG, h, 
+                AStarNode neighborNode(neighbor, tentativeG, components, h,
                                       current.graphNode.getId(), moveUsed);
                 
                 if (!inOpen) {
@@ -145,12 +149,12 @@ vector<GraphNode> GraphAStar::solve(const GraphNode& initial) {
 }
 
 vector<GraphNode> GraphAStar::reconstructPath(const AStarNode& goalNode, 
-                                             const unordered_map<string, AStarNode>& allNodes) {
+                                             const unordered_map<uint64_t, AStarNode>& allNodes) {
     vector<GraphNode> path;
-    string currentId = goalNode.graphNode.getId();
+    uint64_t currentId = goalNode.graphNode.getId();
     
     // Reconstroi o caminho seguindo os pais
-    while (!currentId.empty()) {
+    while (currentId != AStarNode::NO_PARENT) {
         auto it = allNodes.find(currentId);
         if (it != allNodes.end()) {
             path.push_back(it->second.graphNode);
@@ -173,31 +177,84 @@ vector<GraphNode> GraphAStar::reconstructPath(const AStarNode& goalNode,
     return path;
 }
 
+// Deslocamentos do espaço vazio, na ordem de PuzzleGraph::generateNeighbors
+// (cima, baixo, esquerda, direita)
+static const int MOVES[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
 // Versão silenciosa da reconstrução do caminho (para processamento em lote)
-vector<GraphNode> GraphAStar::reconstructPathSilent(const AStarNode& goalNode, 
-                                                   const unordered_map<string, AStarNode>& allNodes) {
-    vector<GraphNode> path;
-    string currentId = goalNode.graphNode.getId();
-    
-    // Reconstrói o caminho seguindo os parentIds
-    while (!currentId.empty()) {
-        auto it = allNodes.find(currentId);
-        if (it != allNodes.end()) {
-            path.push_back(it->second.graphNode);
-            currentId = it->second.parentId;
-        } else {
-            break;
-        }
+vector<GraphNode> GraphAStar::reconstructPathSilent(const GraphNode& initial, uint32_t goalIndex,
+                                                   const vector<SearchNode>& arena) {
+    // Movimentos do objetivo até a raiz, seguindo os pais
+    vector<int> moves;
+    for (uint32_t i = goalIndex; arena[i].parent != SearchNode::NO_PARENT; i = arena[i].parent) {
+        moves.push_back(arena[i].move);
     }
     
-    // Inverte para ter o caminho do início ao fim
-    reverse(path.begin(), path.end());
+    // Reaplica os movimentos a partir do estado inicial
+    vector<GraphNode> path(1, initial);
+    for (auto it = moves.rbegin(); it != moves.rend(); ++it) {
+        auto empty = path.back().getEmptyPosition();
+        path.push_back(path.back().slide(empty.first + MOVES[*it][0], empty.second + MOVES[*it][1]));
+    }
     
     return path;
 }
 
-int GraphAStar::calculateHeuristic(const GraphNode& node) {
-    return node.calculateAdvancedHeuristic();
+void GraphAStar::prepareTables(int size) {
+    tables = &PuzzleHeuristics::forSize(size);
+    walking = &WalkingDistance::forSize(size);
+}
+
+HeuristicState GraphAStar::initialHeuristic(const GraphNode& node) const {
+    int size = node.getSize();
+    int tiles[16];
+    for (int c = 0; c < size * size; c++) {
+        tiles[c] = node.tileAt(c / size, c % size);
+    }
+    
+    HeuristicState components = {};
+    for (int c = 0; c < size * size; c++) {
+        components.manhattan += tables->manhattan[tiles[c]][c];
+    }
+    for (int line = 0; line < size; line++) {
+        components.lineConflicts[line] = tables->rowConflicts[line][node.rowCode(line)];
+        components.lineConflicts[size + line] = tables->colConflicts[line][node.colCode(line)];
+        components.conflicts += components.lineConflicts[line] + components.lineConflicts[size + line];
+    }
+    components.rowWalk = walking->rowIndex(tiles);
+    components.colWalk = walking->colIndex(tiles);
+    return components;
+}
+
+HeuristicState GraphAStar::childHeuristic(const HeuristicState& components, const GraphNode& parent,
+                                          const GraphNode& child) const {
+    int size = parent.getSize();
+    
+    // A peça sai da casa que passa a ser o espaço vazio e vai para o espaço do pai
+    auto childEmpty = child.getEmptyPosition();
+    auto parentEmpty = parent.getEmptyPosition();
+    int fromRow = childEmpty.first, fromCol = childEmpty.second;
+    int toRow = parentEmpty.first, toCol = parentEmpty.second;
+    int t = parent.tileAt(fromRow, fromCol);
+    
+    HeuristicState next = components;
+    next.manhattan += tables->manhattanDelta[t][fromRow * size + fromCol][toRow * size + toCol];
+    
+    // Substitui os conflitos das duas linhas (ou colunas) que mudaram
+    auto replace = [&](int line, int value) {
+        next.conflicts += value - next.lineConflicts[line];
+        next.lineConflicts[line] = value;
+    };
+    if (fromRow == toRow) {
+        replace(size + fromCol, tables->colConflicts[fromCol][child.colCode(fromCol)]);
+        replace(size + toCol, tables->colConflicts[toCol][child.colCode(toCol)]);
+        next.colWalk = walking->step(next.colWalk, fromCol < toCol ? 0 : 1, (t - 1) % size);
+    } else {
+        replace(fromRow, tables->rowConflicts[fromRow][child.rowCode(fromRow)]);
+        replace(toRow, tables->rowConflicts[toRow][child.rowCode(toRow)]);
+        next.rowWalk = walking->step(next.rowWalk, fromRow < toRow ? 0 : 1, (t - 1) / size);
+    }
+    return next;
 }
 
 void GraphAStar::printStatistics() const {
@@ -206,7 +263,11 @@ void GraphAStar::printStatistics() const {
     cerr << "Estados enfileirados: " << statesEnqueued << endl;
 }
 
-// Versão silenciosa para processamento em lote
+// Versão silenciosa para processamento em lote. Cada estado alcançado ganha um
+// SearchNode na arena e uma entrada na StateTable. Um estado alcançado de novo
+// com g menor tem pai, g e movimento atualizados e volta à lista aberta; a
+// entrada antiga fica desatualizada (g maior que o da arena) e é descartada
+// ao sair da fila
 vector<GraphNode> GraphAStar::solveSilent(const GraphNode& initial) {
     auto startTime = chrono::high_resolution_clock::now();
     
@@ -223,20 +284,18 @@ vector<GraphNode> GraphAStar::solveSilent(const GraphNode& initial) {
     }
     
     // Priority queue para o algoritmo A* (min-heap baseado no f-cost)
-    priority_queue<AStarNode, vector<AStarNode>, greater<AStarNode>> openSet;
+    priority_queue<OpenEntry, vector<OpenEntry>, greater<OpenEntry>> openSet;
     
-    // Conjuntos para controle de estados
-    unordered_set<string> closedSet;
-    unordered_set<string> inOpenSet;
-    unordered_map<string, AStarNode> allNodes; // Para reconstruir o caminho
+    // Vértices alcançados e índice de cada estado na arena
+    vector<SearchNode> arena;
+    StateTable indexOf;
     
     // Adiciona o estado inicial
-    int initialH = calculateHeuristic(initial);
-    AStarNode initialNode(initial, 0, initialH);
-    
-    openSet.push(initialNode);
-    inOpenSet.insert(initial.getId());
-    allNodes[initial.getId()] = initialNode;
+    prepareTables(initial.getSize());
+    HeuristicState initialComponents = initialHeuristic(initial);
+    arena.push_back({SearchNode::NO_PARENT, 0, 0});
+    indexOf.findOrInsert(initial.getId(), 0);
+    openSet.push({initial, 0, 0, (uint16_t)heuristicValue(initialComponents), initialComponents});
     statesEnqueued++;
     
     const int MAX_STATES = (initial.getSize() == 3) ? 500000 : 5000000; // 5M para 15-puzzle, 500k para 8-puzzle
@@ -244,54 +303,44 @@ vector<GraphNode> GraphAStar::solveSilent(const GraphNode& initial) {
     
     while (!openSet.empty() && statesEvaluated < MAX_STATES) {
         // Pega o nó com menor f-cost (vértice mais promissor)
-        AStarNode current = openSet.top();
+        OpenEntry current = openSet.top();
         openSet.pop();
-        
-        // Remove do conjunto de estados abertos
-        inOpenSet.erase(current.graphNode.getId());
-        
-        // Adiciona ao conjunto de estados fechados (vértices visitados)
-        closedSet.insert(current.graphNode.getId());
+        if (current.gCost != arena[current.index].gCost) {
+            continue; // Entrada desatualizada: o estado foi alcançado com g menor
+        }
         statesEvaluated++;
         
         // Verifica se chegou ao objetivo
         if (current.graphNode.isGoal()) {
             auto endTime = chrono::high_resolution_clock::now();
             executionTime = endTime - startTime;
-            return reconstructPathSilent(current, allNodes);
+            return reconstructPathSilent(initial, current.index, arena);
         }
         
         // Gera vizinhos (arestas do grafo)
-        vector<pair<GraphNode, string>> neighbors = graph.generateNeighbors(current.graphNode);
-        
-        for (const auto& neighborPair : neighbors) {
-            const GraphNode& neighbor = neighborPair.first;
-            const string& move = neighborPair.second;
+        auto empty = current.graphNode.getEmptyPosition();
+        for (int move = 0; move < 4; move++) {
+            int row = empty.first + MOVES[move][0];
+            int col = empty.second + MOVES[move][1];
+            if (row < 0 || row >= size || col < 0 || col >= size) continue;
             
-            // Ignora se já foi avaliado (vértice já visitado)
-            if (closedSet.find(neighbor.getId()) != closedSet.end()) {
+            GraphNode neighbor = current.graphNode.slide(row, col);
+            int neighborG = current.gCost + 1;
+            uint32_t index = indexOf.findOrInsert(neighbor.getId(), arena.size());
+            if (index == StateTable::MISSING) {
+                index = arena.size();
+                arena.push_back({current.index, (uint16_t)neighborG, (uint8_t)move});
+            } else if (neighborG < arena[index].gCost) {
+                // Caminho mais curto até um estado já alcançado
+                arena[index] = {current.index, (uint16_t)neighborG, (uint8_t)move};
+            } else {
                 continue;
             }
             
-            // Adiciona aresta ao grafo
-            graph.addEdge(current.graphNode, neighbor, move);
-            
-            int neighborG = current.gCost + 1;
-            int neighborH = calculateHeuristic(neighbor);
-            AStarNode neighborNode(neighbor, neighborG, neighborH, current.graphNode.getId(), move);
-            
-            // Se não está na lista aberta ou encontrou caminho melhor
-            if (inOpenSet.find(neighbor.getId()) == inOpenSet.end()) {
-                // Para 15-puzzle, verifica se já está em closedSet para economizar memória
-                if (size == 4 && closedSet.find(neighbor.getId()) != closedSet.end()) {
-                    continue;
-                }
-                
-                openSet.push(neighborNode);
-                inOpenSet.insert(neighbor.getId());
-                allNodes[neighbor.getId()] = neighborNode;
-                statesEnqueued++;
-            }
+            HeuristicState components = childHeuristic(current.components, current.graphNode, neighbor);
+            openSet.push({neighbor, index, (uint16_t)neighborG, (uint16_t)heuristicValue(components),
+                          components});
+            statesEnqueued++;
         }
     }
     
@@ -1,27 +1,46 @@
 #pragma once
 
 #include "PuzzleGraph.hpp"
+#include "PuzzleHeuristics.hpp"
+#include "StateTable.hpp"
+#include "WalkingDistance.hpp"
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <chrono>
 #include <queue>
+#include <algorithm>
 
 using namespace std;
 
+// Componentes da heurística de um vértice, guardadas no nó para que o h de um
+// vizinho saia em O(1): o movimento de uma peça muda o seu termo de Manhattan,
+// duas linhas (ou colunas) e um dos estados da walking distance
+struct HeuristicState {
+    uint8_t manhattan;
+    uint8_t conflicts;          // Soma de lineConflicts
+    uint8_t lineConflicts[8];   // Conflitos de cada linha (0..3) e coluna (4..7)
+    uint16_t rowWalk, colWalk;  // Estados da walking distance (ver WalkingDistance)
+};
+
 // Estrutura para representar um nó na busca A*
 struct AStarNode {
     GraphNode graphNode;
     int gCost;           // Custo do caminho desde o início
-    int hCost;           // Heurística (Manhattan distance)
-    string parentId;     // ID do nó pai para reconstruir o caminho
+    int hCost;           // Heurística (ver GraphAStar::heuristicValue)
+    HeuristicState components;
+    uint64_t parentId;   // ID do nó pai para reconstruir o caminho (NO_PARENT na raiz)
     string moveUsed;     // Movimento usado para chegar aqui
     
-    AStarNode() : gCost(0), hCost(0), parentId(""), moveUsed("") {}
+    // Nenhum tabuleiro válido tem todas as casas vazias, então 0 não é um ID
+    static const uint64_t NO_PARENT = 0;
+    
+    AStarNode() : gCost(0), hCost(0), components(), parentId(NO_PARENT), moveUsed("") {}
     
-    AStarNode(const GraphNode& node, int g = 0, int h = 0, 
-              const string& parent = "", const string& move = "")
-        : graphNode(node), gCost(g), hCost(h), parentId(parent), moveUsed(move) {}
+    AStarNode(const GraphNode& node, int g, const HeuristicState& components, int h,
+              uint64_t parent = NO_PARENT, const string& move = "")
+        : graphNode(node), gCost(g), hCost(h), components(components), parentId(parent),
+          moveUsed(move) {}
     
     int getFCost() const { return gCost + hCost; }
     
@@ -37,9 +56,43 @@ struct AStarNode {
     }
 };
 
+// Vértice da busca em solveSilent, guardado em uma arena contígua (8 bytes).
+// O tabuleiro não é guardado: o caminho é refeito aplicando os movimentos a
+// partir do estado inicial, e o estado de cada vértice só é chave na StateTable
+struct SearchNode {
+    uint32_t parent;   // Índice do pai na arena (NO_PARENT na raiz)
+    uint16_t gCost;    // Menor g conhecido; entradas abertas com g maior são descartadas
+    uint8_t move;      // Direção do espaço vazio a partir do pai (0..3, ver MOVES)
+    
+    static const uint32_t NO_PARENT = UINT32_MAX;
+};
+
+// Entrada da lista aberta de solveSilent: só os vértices abertos carregam o
+// tabuleiro e as componentes da heurística
+struct OpenEntry {
+    GraphNode graphNode;
+    uint32_t index;    // Índice na arena
+    uint16_t gCost;
+    uint16_t hCost;
+    HeuristicState components;
+    
+    // Mesma ordem de AStarNode (f, depois h)
+    bool operator>(const OpenEntry& other) const {
+        int thisFCost = gCost + hCost;
+        int otherFCost = other.gCost + other.hCost;
+        
+        if (thisFCost != otherFCost) {
+            return thisFCost > otherFCost;
+        }
+        return hCost > other.hCost;
+    }
+};
+
 class GraphAStar {
 private:
     PuzzleGraph graph;
+    const PuzzleHeuristics* tables;
+    const WalkingDistance* walking;
     int statesEvaluated;
     int statesEnqueued;
     chrono::duration<double> executionTime;
@@ -67,12 +120,26 @@ public:
 private:
     // Reconstroi o caminho da solução
     vector<GraphNode> reconstructPath(const AStarNode& goalNode, 
-                                     const unordered_map<string, AStarNode>& allNodes);
+                                     const unordered_map<uint64_t, AStarNode>& allNodes);
+    
+    // Reconstroi o caminho da solução (versão silenciosa) a partir dos
+    // movimentos guardados na arena
+    vector<GraphNode> reconstructPathSilent(const GraphNode& initial, uint32_t goalIndex,
+                                           const vector<SearchNode>& arena);
     
-    // Reconstroi o caminho da solução (versão silenciosa)
-    vector<GraphNode> reconstructPathSilent(const AStarNode& goalNode, 
-                                           const unordered_map<string, AStarNode>& allNodes);
+    // Carrega as tabelas do tamanho do puzzle
+    void prepareTables(int size);
     
-    // Calcula a heurística para um nó
-    int calculateHeuristic(const GraphNode& node);
+    // Componentes da heurística calculadas do zero (estado inicial) e a partir
+    // das do pai, para o vizinho child de parent, em O(1)
+    HeuristicState initialHeuristic(const GraphNode& node) const;
+    HeuristicState childHeuristic(const HeuristicState& components, const GraphNode& parent,
+                                  const GraphNode& child) const;
+    
+    // Maior entre Manhattan + 2 * conflitos lineares e a walking distance, o
+    // mesmo valor de GraphNode::calculateAdvancedHeuristic
+    int heuristicValue(const HeuristicState& components) const {
+        return max(components.manhattan + 2 * components.conflicts,
+                   walking->distance[components.rowWalk] + walking->distance[components.colWalk]);
+    }
 };
@@ -0,0 +1,165 @@
+#include "GraphIDAStar.hpp"
+#include <iostream>
+#include <climits>
+
+// Valor de retorno de search quando o objetivo é encontrado
+static const int FOUND = -1;
+
+GraphIDAStar::GraphIDAStar(const PatternDatabase* patterns)
+    : statesEvaluated(0), statesGenerated(0), iterations(0), tables(nullptr),
+      size(0), blank(0), manhattan(0), conflicts(0), walking(nullptr), rowWalk(0),
+      colWalk(0), patterns(patterns),
+      activePatterns(nullptr), patternExtra(0) {}
+
+void GraphIDAStar::slide(int cell) {
+    int t = tiles[cell];
+    int from = cell, to = blank;
+
+    manhattan += tables->manhattanDelta[t][from][to];
+
+    // Um movimento horizontal muda a composição de duas colunas e um vertical
+    // a de duas linhas; na linha (coluna) do movimento a peça só troca de casa
+    // com o espaço, sem mudar a ordem das peças nem os conflitos
+    int fromRow = from / size, fromCol = from % size;
+    int toRow = to / size, toCol = to % size;
+    if (fromRow == toRow) {
+        colWalk = walking->step(colWalk, fromCol < toCol ? 0 : 1, (t - 1) % size);
+        conflicts -= tables->colConflicts[fromCol][colCode[fromCol]] +
+                     tables->colConflicts[toCol][colCode[toCol]];
+        colCode[fromCol] &= ~(0xFu << (4 * fromRow));
+        colCode[toCol] |= (uint32_t)t << (4 * toRow);
+        conflicts += tables->colConflicts[fromCol][colCode[fromCol]] +
+                     tables->colConflicts[toCol][colCode[toCol]];
+        rowCode[fromRow] ^= ((uint32_t)t << (4 * fromCol)) ^ ((uint32_t)t << (4 * toCol));
+    } else {
+        rowWalk = walking->step(rowWalk, fromRow < toRow ? 0 : 1, (t - 1) / size);
+        conflicts -= tables->rowConflicts[fromRow][rowCode[fromRow]] +
+                     tables->rowConflicts[toRow][rowCode[toRow]];
+        rowCode[fromRow] &= ~(0xFu << (4 * fromCol));
+        rowCode[toRow] |= (uint32_t)t << (4 * toCol);
+        conflicts += tables->rowConflicts[fromRow][rowCode[fromRow]] +
+                     tables->rowConflicts[toRow][rowCode[toRow]];
+        colCode[fromCol] ^= ((uint32_t)t << (4 * fromRow)) ^ ((uint32_t)t << (4 * toRow));
+    }
+
+    // Só o grupo da peça movida muda de índice
+    if (activePatterns) {
+        int g = activePatterns->groupOf(t);
+        position[t] = to;
+        if (g >= 0) {
+            patternExtra -= activePatterns->extra(g, groupIndex[g]);
+            groupIndex[g] = activePatterns->index(g, position);
+            patternExtra += activePatterns->extra(g, groupIndex[g]);
+        }
+    }
+
+    tiles[to] = t;
+    tiles[from] = 0;
+    blank = from;
+}
+
+int GraphIDAStar::search(int g, int bound, int previous) {
+    int h = heuristic();
+    int f = g + h;
+    if (f > bound) return f;
+    if (h == 0) return FOUND;  // Manhattan zero só no objetivo
+
+    statesEvaluated++;
+    int next = INT_MAX;
+    int here = blank;
+    for (int k = 0; k < neighborCount[here]; k++) {
+        int cell = neighbors[here][k];
+        if (cell == previous) continue;  // Desfaria o movimento anterior
+
+        statesGenerated++;
+        slide(cell);
+        path.push_back(cell);
+        int result = search(g + 1, bound, here);
+        if (result == FOUND) return FOUND;
+        path.pop_back();
+        slide(here);
+
+        next = min(next, result);
+    }
+    return next;
+}
+
+vector<GraphNode> GraphIDAStar::solveSilent(const GraphNode& initial) {
+    auto startTime = chrono::high_resolution_clock::now();
+
+    // Reset das estatísticas
+    statesEvaluated = 0;
+    statesGenerated = 0;
+    iterations = 0;
+    path.clear();
+
+    if (!initial.isSolvable()) {
+        executionTime = chrono::high_resolution_clock::now() - startTime;
+        return {};
+    }
+
+    // Carrega o tabuleiro e as componentes da heurística
+    size = initial.getSize();
+    tables = &PuzzleHeuristics::forSize(size);
+    for (int c = 0; c < size * size; c++) {
+        tiles[c] = initial.tileAt(c / size, c % size);
+        if (tiles[c] == 0) blank = c;
+
+        int row = c / size, col = c % size;
+        neighborCount[c] = 0;
+        if (row > 0) neighbors[c][neighborCount[c]++] = c - size;
+        if (row < size - 1) neighbors[c][neighborCount[c]++] = c + size;
+        if (col > 0) neighbors[c][neighborCount[c]++] = c - 1;
+        if (col < size - 1) neighbors[c][neighborCount[c]++] = c + 1;
+    }
+    manhattan = 0;
+    conflicts = 0;
+    for (int line = 0; line < size; line++) {
+        rowCode[line] = tables->rowCode(tiles, line);
+        colCode[line] = tables->colCode(tiles, line);
+        conflicts += tables->rowConflicts[line][rowCode[line]] +
+                     tables->colConflicts[line][colCode[line]];
+    }
+    for (int c = 0; c < size * size; c++) {
+        manhattan += tables->manhattan[tiles[c]][c];
+    }
+    walking = &WalkingDistance::forSize(size);
+    rowWalk = walking->rowIndex(tiles);
+    colWalk = walking->colIndex(tiles);
+
+    activePatterns = (size == 4 && patterns && patterns->loaded()) ? patterns : nullptr;
+    patternExtra = 0;
+    if (activePatterns) {
+        for (int c = 0; c < 16; c++) position[tiles[c]] = c;
+        for (int g = 0; g < activePatterns->groupCount(); g++) {
+            groupIndex[g] = activePatterns->index(g, position);
+            patternExtra += activePatterns->extra(g, groupIndex[g]);
+        }
+    }
+
+    // Aprofundamento iterativo: cada iteração usa como limite o menor f que
+    // excedeu o limite anterior
+    int bound = heuristic();
+    for (;;) {
+        iterations++;
+        int result = search(0, bound, -1);
+        if (result == FOUND) break;
+        bound = result;
+    }
+
+    // O caminho é refeito a partir do estado inicial com as casas do espaço vazio
+    vector<GraphNode> solution(1, initial);
+    for (int cell : path) {
+        solution.push_back(solution.back().slide(cell / size, cell % size));
+    }
+
+    executionTime = chrono::high_resolution_clock::now() - startTime;
+    return solution;
+}
+
+void GraphIDAStar::printStatistics() const {
+    cerr << "Tempo de execução: " << executionTime.count() << " segundos" << endl;
+    cerr << "Estados avaliados: " << statesEvaluated << endl;
+    cerr << "Estados enfileirados: " << statesGenerated << endl;
+    cerr << "Iterações do IDA*: " << iterations << endl;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "PatternDatabase.hpp"
+#include "PuzzleGraph.hpp"
+#include "PuzzleHeuristics.hpp"
+#include "WalkingDistance.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Busca IDA* (A* com aprofundamento iterativo) no grafo de estados: uma busca
+// em profundidade limitada por f = g + h, repetida com o limite elevado ao
+// menor f que o excedeu. Não guarda conjuntos de estados: um único tabuleiro
+// é alterado no lugar (fazer/desfazer movimento), a heurística é atualizada
+// pela diferença do movimento e o movimento que desfaz o anterior é podado,
+// então a memória é O(profundidade).
+// Heurística: o maior entre Manhattan + conflitos lineares (PuzzleHeuristics),
+// a walking distance (WalkingDistance) e, no 15-puzzle com banco de padrões,
+// o valor do banco (PatternDatabase); todas admissíveis, de modo que a
+// solução é ótima.
+class GraphIDAStar {
+private:
+    long long statesEvaluated;  // Vértices expandidos (todas as iterações)
+    long long statesGenerated;  // Sucessores gerados
+    int iterations;
+    chrono::duration<double> executionTime;
+
+    // Tabuleiro da busca e componentes da heurística
+    const PuzzleHeuristics* tables;
+    int size;
+    int tiles[16];
+    int blank;
+    uint32_t rowCode[4], colCode[4];
+    int manhattan;
+    int conflicts;
+    const WalkingDistance* walking;
+    int rowWalk, colWalk;  // Estados da walking distance das linhas e colunas
+
+    // Banco de padrões (nulo se não usado): casa de cada peça, índice de cada
+    // grupo e soma dos extras dos grupos
+    const PatternDatabase* patterns;
+    const PatternDatabase* activePatterns;
+    int position[16];
+    uint32_t groupIndex[16];
+    int patternExtra;
+
+    // Casas vizinhas de cada casa (destinos possíveis do espaço vazio)
+    int neighborCount[16];
+    int neighbors[16][4];
+
+    // Casas ocupadas pelo espaço vazio ao longo do caminho atual
+    vector<int> path;
+
+public:
+    // patterns é usado apenas no 15-puzzle e precisa sobreviver ao solver
+    explicit GraphIDAStar(const PatternDatabase* patterns = nullptr);
+
+    // Resolve o puzzle; vazio se for insolúvel
+    vector<GraphNode> solveSilent(const GraphNode& initial);
+
+    // Getters para estatísticas
+    long long getStatesEvaluated() const { return statesEvaluated; }
+    long long getStatesGenerated() const { return statesGenerated; }
+    int getIterations() const { return iterations; }
+    double getExecutionTime() const { return executionTime.count(); }
+
+    // Método para imprimir estatísticas
+    void printStatistics() const;
+
+private:
+    // Busca em profundidade a partir do tabuleiro atual com custo g; retorna
+    // FOUND ao chegar ao objetivo ou o menor f acima de bound
+    int search(int g, int bound, int previous);
+
+    // Move o espaço vazio para a casa cell (vizinha), atualizando a heurística;
+    // desfazer é mover o espaço de volta
+    void slide(int cell);
+
+    int heuristic() const {
+        return max(manhattan + 2 * max(conflicts, patternExtra),
+                   walking->distance[rowWalk] + walking->distance[colWalk]);
+    }
+};
@@ -0,0 +1,317 @@
+#include "PatternDatabase.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Canto superior esquerdo (1-2-3-5-6-7), borda direita e inferior junto do
+// espaço vazio (4-8-11-12-14-15) e o restante (9-10-13); entre as partições
+// 6-6-3 testadas, a que mais reduz as expansões nas instâncias de Korf
+const vector<vector<int>> PatternDatabase::DEFAULT_PARTITION = {
+    {1, 2, 3, 5, 6, 7},
+    {4, 8, 11, 12, 14, 15},
+    {9, 10, 13},
+};
+
+static const char MAGIC[4] = {'G', 'P', 'D', 'B'};
+static const uint8_t UNSEEN = 0xFF;
+
+// Número de posicionamentos de k peças distintas em 16 casas: 16!/(16-k)!
+static uint32_t placementCount(int k) {
+    uint32_t count = 1;
+    for (int i = 0; i < k; i++) count *= 16 - i;
+    return count;
+}
+
+static size_t alignedSize(size_t bytes) {
+    return (bytes + 7) & ~(size_t)7;
+}
+
+// Índice de um posicionamento: as casas em base mista 16, 15, 14, ..., cada
+// uma contada só entre as casas ainda livres
+static uint32_t placementRank(const int* cells, int k) {
+    uint32_t index = 0;
+    uint32_t used = 0;
+    for (int i = 0; i < k; i++) {
+        int c = cells[i];
+        int free = c - __builtin_popcount(used & ((1u << c) - 1));
+        index = index * (16 - i) + free;
+        used |= 1u << c;
+    }
+    return index;
+}
+
+static void placementUnrank(uint32_t index, int k, int* cells) {
+    int free[8];
+    for (int i = k - 1; i >= 0; i--) {
+        free[i] = index % (16 - i);
+        index /= 16 - i;
+    }
+    uint32_t used = 0;
+    for (int i = 0; i < k; i++) {
+        int c = 0;
+        for (int skip = free[i];; c++) {
+            if (used & (1u << c)) continue;
+            if (skip-- == 0) break;
+        }
+        cells[i] = c;
+        used |= 1u << c;
+    }
+}
+
+static int manhattanOf(int tile, int cell) {
+    int goal = tile - 1;
+    return abs(cell / 4 - goal / 4) + abs(cell % 4 - goal % 4);
+}
+
+// Distâncias de um grupo: busca em largura sobre (posicionamento, espaço vazio)
+// em que só os movimentos de peças do grupo custam 1. Os estados alcançados de
+// graça (o espaço vazio andando pelas casas livres) recebem o mesmo nível no
+// momento em que o primeiro deles é alcançado, então cada passada sobre a
+// tabela expande exatamente um nível
+static vector<uint8_t> groupDistances(const vector<int>& tiles) {
+    int k = tiles.size();
+    uint32_t placements = placementCount(k);
+    vector<uint8_t> dist((size_t)placements * 16, UNSEEN);
+
+    int neighbors[16][4], neighborCount[16];
+    for (int c = 0; c < 16; c++) {
+        neighborCount[c] = 0;
+        if (c >= 4) neighbors[c][neighborCount[c]++] = c - 4;
+        if (c < 12) neighbors[c][neighborCount[c]++] = c + 4;
+        if (c % 4 > 0) neighbors[c][neighborCount[c]++] = c - 1;
+        if (c % 4 < 3) neighbors[c][neighborCount[c]++] = c + 1;
+    }
+
+    // Marca com level todas as casas livres alcançáveis pelo espaço vazio
+    int stack[16];
+    auto flood = [&](uint32_t index, uint32_t occupied, int start, uint8_t level) {
+        uint8_t* block = &dist[(size_t)index * 16];
+        int top = 0;
+        block[start] = level;
+        stack[top++] = start;
+        while (top > 0) {
+            int c = stack[--top];
+            for (int j = 0; j < neighborCount[c]; j++) {
+                int n = neighbors[c][j];
+                if ((occupied & (1u << n)) || block[n] != UNSEEN) continue;
+                block[n] = level;
+                stack[top++] = n;
+            }
+        }
+    };
+
+    int cells[8];
+    uint32_t occupied = 0;
+    for (int i = 0; i < k; i++) {
+        cells[i] = tiles[i] - 1;
+        occupied |= 1u << cells[i];
+    }
+    flood(placementRank(cells, k), occupied, 15, 0);
+
+    const uint8_t* begin = dist.data();
+    const uint8_t* end = begin + dist.size();
+    for (uint8_t level = 0;; level++) {
+        if (level + 1 == UNSEEN) throw runtime_error("banco de padrões: profundidade excedida");
+        bool expanded = false;
+
+        for (const uint8_t* p = begin;
+             (p = (const uint8_t*)memchr(p, level, end - p)) != nullptr;) {
+            uint32_t index = (p - begin) / 16;
+            const uint8_t* block = begin + (size_t)index * 16;
+            p = block + 16;
+
+            placementUnrank(index, k, cells);
+            int owner[16];
+            occupied = 0;
+            for (int c = 0; c < 16; c++) owner[c] = -1;
+            for (int i = 0; i < k; i++) {
+                owner[cells[i]] = i;
+                occupied |= 1u << cells[i];
+            }
+
+            for (int b = 0; b < 16; b++) {
+                if (block[b] != level) continue;
+                for (int j = 0; j < neighborCount[b]; j++) {
+                    int n = neighbors[b][j];
+                    int i = owner[n];
+                    if (i < 0) continue;
+
+                    // A peça i vai para a casa do espaço vazio
+                    cells[i] = b;
+                    uint32_t next = placementRank(cells, k);
+                    cells[i] = n;
+                    if (dist[(size_t)next * 16 + n] != UNSEEN) continue;
+                    flood(next, occupied ^ (1u << n) ^ (1u << b), n, level + 1);
+                    expanded = true;
+                }
+            }
+        }
+        if (!expanded) break;
+    }
+    return dist;
+}
+
+void PatternDatabase::build(const vector<vector<int>>& partition, const string& path) {
+    bool seen[16] = {};
+    for (const vector<int>& tiles : partition) {
+        if (tiles.empty() || tiles.size() > 7) {
+            throw runtime_error("banco de padrões: grupos devem ter de 1 a 7 peças");
+        }
+        for (int t : tiles) {
+            if (t < 1 || t > 15 || seen[t]) {
+                throw runtime_error("banco de padrões: partição inválida");
+            }
+            seen[t] = true;
+        }
+    }
+
+    // Tabelas de todos os grupos antes de abrir o arquivo
+    vector<vector<uint8_t>> blocks;
+    for (const vector<int>& tiles : partition) {
+        int k = tiles.size();
+        vector<uint8_t> dist = groupDistances(tiles);
+
+        // Menor custo sobre as casas do espaço vazio, gravado como extra sobre
+        // Manhattan das peças do grupo
+        uint32_t placements = placementCount(k);
+        vector<uint8_t> nibbles(alignedSize((placements + 1) / 2), 0);
+        int cells[8];
+        for (uint32_t index = 0; index < placements; index++) {
+            int best = UNSEEN;
+            for (int b = 0; b < 16; b++) best = min(best, (int)dist[(size_t)index * 16 + b]);
+
+            placementUnrank(index, k, cells);
+            int distance = 0;
+            for (int i = 0; i < k; i++) distance += manhattanOf(tiles[i], cells[i]);
+            int extra = (best - distance) / 2;
+            if (best == UNSEEN || best < distance || (best - distance) % 2 != 0 || extra > 15) {
+                throw runtime_error("banco de padrões: valor fora do formato em nibble");
+            }
+            nibbles[index >> 1] |= extra << ((index & 1) * 4);
+        }
+        blocks.push_back(move(nibbles));
+    }
+
+    vector<int32_t> header;
+    header.push_back((int32_t)partition.size());
+    for (const vector<int>& tiles : partition) {
+        header.push_back((int32_t)tiles.size());
+        header.insert(header.end(), tiles.begin(), tiles.end());
+    }
+    size_t headerBytes = sizeof(MAGIC) + header.size() * sizeof(int32_t);
+    vector<uint8_t> padding(alignedSize(headerBytes) - headerBytes, 0);
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) throw runtime_error("Não foi possível criar o arquivo " + path);
+    bool ok = fwrite(MAGIC, 1, sizeof(MAGIC), file) == sizeof(MAGIC) &&
+              fwrite(header.data(), sizeof(int32_t), header.size(), file) == header.size() &&
+              fwrite(padding.data(), 1, padding.size(), file) == padding.size();
+    for (const vector<uint8_t>& nibbles : blocks) {
+        ok = ok && fwrite(nibbles.data(), 1, nibbles.size(), file) == nibbles.size();
+    }
+    if (fclose(file) != 0 || !ok) {
+        throw runtime_error("Erro ao gravar o arquivo " + path);
+    }
+}
+
+PatternDatabase::PatternDatabase() : mapped(nullptr), mappedSize(0) {
+    for (int t = 0; t < 16; t++) tileGroup[t] = -1;
+}
+
+PatternDatabase::~PatternDatabase() {
+    release();
+}
+
+void PatternDatabase::release() {
+    if (mapped) munmap(mapped, mappedSize);
+    mapped = nullptr;
+    mappedSize = 0;
+    groups.clear();
+    for (int t = 0; t < 16; t++) tileGroup[t] = -1;
+}
+
+void PatternDatabase::load(const string& path) {
+    release();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw runtime_error("Não foi possível abrir o arquivo " + path);
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)(sizeof(MAGIC) + sizeof(int32_t))) {
+        close(fd);
+        throw runtime_error("Banco de padrões inválido: " + path);
+    }
+    void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) throw runtime_error("Não foi possível mapear o arquivo " + path);
+    mapped = address;
+    mappedSize = info.st_size;
+
+    // Lê o cabeçalho validando cada campo contra o tamanho do arquivo
+    const uint8_t* bytes = (const uint8_t*)mapped;
+    size_t offset = sizeof(MAGIC);
+    auto readInt = [&](int32_t& value) {
+        if (offset + sizeof(int32_t) > mappedSize) return false;
+        memcpy(&value, bytes + offset, sizeof(int32_t));
+        offset += sizeof(int32_t);
+        return true;
+    };
+
+    bool valid = memcmp(bytes, MAGIC, sizeof(MAGIC)) == 0;
+    int32_t count = 0;
+    valid = valid && readInt(count) && count > 0 && count <= 15;
+    for (int32_t g = 0; valid && g < count; g++) {
+        int32_t k = 0;
+        valid = readInt(k) && k >= 1 && k <= 7;
+        Group group;
+        group.data = nullptr;
+        for (int32_t i = 0; valid && i < k; i++) {
+            int32_t t = 0;
+            valid = readInt(t) && t >= 1 && t <= 15 && tileGroup[t] < 0;
+            if (valid) {
+                tileGroup[t] = g;
+                group.tiles.push_back(t);
+            }
+        }
+        groups.push_back(group);
+    }
+
+    offset = alignedSize(offset);
+    for (Group& group : groups) {
+        if (!valid) break;
+        size_t bytesNeeded = alignedSize((placementCount(group.tiles.size()) + 1) / 2);
+        valid = offset + bytesNeeded <= mappedSize;
+        group.data = bytes + offset;
+        offset += bytesNeeded;
+    }
+
+    if (!valid) {
+        release();
+        throw runtime_error("Banco de padrões inválido: " + path);
+    }
+}
+
+uint32_t PatternDatabase::index(int g, const int* position) const {
+    const vector<int>& tiles = groups[g].tiles;
+    int cells[8];
+    for (size_t i = 0; i < tiles.size(); i++) cells[i] = position[tiles[i]];
+    return placementRank(cells, tiles.size());
+}
+
+int PatternDatabase::evaluate(const int* tiles) const {
+    int position[16];
+    int distance = 0;
+    for (int c = 0; c < 16; c++) {
+        position[tiles[c]] = c;
+        if (tiles[c] != 0) distance += manhattanOf(tiles[c], c);
+    }
+
+    int extras = 0;
+    for (int g = 0; g < groupCount(); g++) extras += extra(g, index(g, position));
+    return distance + 2 * extras;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Banco de padrões aditivo e disjunto para o 15-puzzle. As peças são divididas
+// em grupos; para cada grupo, a tabela guarda o menor número de movimentos DAS
+// PEÇAS DO GRUPO (as demais são indistintas e se movem de graça) para levá-las
+// às casas objetivo a partir de qualquer posicionamento. Como cada movimento
+// move uma só peça, a soma sobre os grupos é admissível.
+//
+// Cada valor do grupo é Manhattan das suas peças + 2 * extra (a diferença é
+// sempre par), e só extra é gravado, em um nibble. Assim a heurística completa
+// é Manhattan + 2 * soma dos extras, com Manhattan já mantido pela busca.
+//
+// Formato do arquivo: assinatura "GPDB", número de grupos e, para cada grupo,
+// o número de peças, as peças e os nibbles de todos os posicionamentos (índice
+// pela permutação parcial das casas), com cada bloco em offset
+// múltiplo de 8. O arquivo é mapeado com mmap e consultado sem cópia.
+class PatternDatabase {
+public:
+    // Partição 6-6-3 usada por padrão (objetivo com o espaço vazio na última casa)
+    static const vector<vector<int>> DEFAULT_PARTITION;
+
+    PatternDatabase();
+    ~PatternDatabase();
+    PatternDatabase(const PatternDatabase&) = delete;
+    PatternDatabase& operator=(const PatternDatabase&) = delete;
+
+    // Gera as tabelas da partição por busca em largura e grava em path;
+    // lança runtime_error se não for possível gravar. Um grupo de k peças usa
+    // 16 * 16!/(16-k)! bytes durante a busca (92 MB para k = 6)
+    static void build(const vector<vector<int>>& partition, const string& path);
+
+    // Mapeia um arquivo gravado por build; lança runtime_error se inválido
+    void load(const string& path);
+
+    bool loaded() const { return mapped != nullptr; }
+    int groupCount() const { return (int)groups.size(); }
+
+    // Grupo da peça t (-1 se a peça não pertence a nenhum)
+    int groupOf(int t) const { return tileGroup[t]; }
+
+    // Índice do grupo g dadas as casas de todas as peças (position[t])
+    uint32_t index(int g, const int* position) const;
+
+    // Extra (nibble) do grupo g no posicionamento de índice idx
+    int extra(int g, uint32_t idx) const {
+        const uint8_t* data = groups[g].data;
+        return (data[idx >> 1] >> ((idx & 1) * 4)) & 0xF;
+    }
+
+    // Manhattan + 2 * soma dos extras, calculado do zero para um tabuleiro linear
+    int evaluate(const int* tiles) const;
+
+private:
+    struct Group {
+        vector<int> tiles;
+        const uint8_t* data;
+    };
+
+    vector<Group> groups;
+    int tileGroup[16];
+    void* mapped;
+    size_t mappedSize;
+
+    void release();
+};
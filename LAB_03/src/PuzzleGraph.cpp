@@ -1,12 +1,15 @@
 #include "PuzzleGraph.hpp"
+#include "PuzzleHeuristics.hpp"
+#include "WalkingDistance.hpp"
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <iostream>
+#include <stdexcept>
 
 // ===== Implementação da classe GraphNode =====
 
-GraphNode::GraphNode() : size(0), emptyRow(0), emptyCol(0) {}
+GraphNode::GraphNode() : packed(0), size(0), emptyPos(0) {}
 
 GraphNode::GraphNode(const vector<int>& input) {
     if (input.size() == 9) {
@@ -17,68 +20,82 @@ GraphNode::GraphNode(const vector<int>& input) {
         throw invalid_argument("Entrada inválida: deve ter 9 ou 16 elementos");
     }
     
-    state.resize(size, vector<int>(size));
-    
-    // Converte entrada linear para matriz
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            state[i][j] = input[i * size + j];
+    // pack guarda 4 bits por casa: só uma permutação de 0..n²-1 é representável
+    vector<bool> seen(input.size(), false);
+    for (int tile : input) {
+        if (tile < 0 || tile >= (int)input.size() || seen[tile]) {
+            throw invalid_argument("Entrada inválida: as peças devem ser uma permutação de 0 a " +
+                                   to_string(input.size() - 1));
         }
+        seen[tile] = true;
     }
     
-    findEmptyPosition();
-    generateId();
+    pack(input);
 }
 
-GraphNode::GraphNode(const vector<vector<int>>& state) : state(state) {
+GraphNode::GraphNode(const vector<vector<int>>& state) {
     size = state.size();
-    findEmptyPosition();
-    generateId();
+    
+    // Converte a matriz para entrada linear
+    vector<int> tiles;
+    for (const auto& row : state) {
+        tiles.insert(tiles.end(), row.begin(), row.end());
+    }
+    pack(tiles);
 }
 
-void GraphNode::findEmptyPosition() {
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            if (state[i][j] == 0) {
-                emptyRow = i;
-                emptyCol = j;
-                return;
-            }
+void GraphNode::pack(const vector<int>& tiles) {
+    packed = 0;
+    emptyPos = 0;
+    for (int i = 0; i < size * size; i++) {
+        packed |= (uint64_t)(tiles[i] & 0xF) << (4 * i);
+        if (tiles[i] == 0) {
+            emptyPos = i;
         }
     }
 }
 
-void GraphNode::generateId() {
-    stringstream ss;
+vector<vector<int>> GraphNode::getState() const {
+    vector<vector<int>> state(size, vector<int>(size));
     for (int i = 0; i < size; i++) {
         for (int j = 0; j < size; j++) {
-            if (i > 0 || j > 0) ss << "-";
-            ss << state[i][j];
+            state[i][j] = tileAt(i, j);
         }
     }
-    id = ss.str();
+    return state;
 }
 
-vector<vector<int>> GraphNode::getGoalState() const {
-    vector<vector<int>> goal(size, vector<int>(size));
-    int num = 1;
+GraphNode GraphNode::slide(int row, int col) const {
+    int from = row * size + col;
+    uint64_t tile = (packed >> (4 * from)) & 0xF;
     
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            if (i == size - 1 && j == size - 1) {
-                goal[i][j] = 0; // Posição vazia no final
-            } else {
-                goal[i][j] = num++;
-            }
-        }
+    // A casa de origem fica vazia (nibble 0) e a peça vai para o espaço
+    GraphNode next = *this;
+    next.packed = (packed & ~((uint64_t)0xF << (4 * from))) | (tile << (4 * emptyPos));
+    next.emptyPos = from;
+    return next;
+}
+
+string GraphNode::getLabel() const {
+    stringstream ss;
+    for (int i = 0; i < size * size; i++) {
+        if (i > 0) ss << "-";
+        ss << tileAt(i / size, i % size);
+    }
+    return ss.str();
+}
+
+uint64_t GraphNode::getGoalState() const {
+    // Peças 1, 2, ..., size² - 1 em ordem e o espaço vazio na última casa
+    uint64_t goal = 0;
+    for (int i = 0; i < size * size - 1; i++) {
+        goal |= (uint64_t)(i + 1) << (4 * i);
     }
-    
     return goal;
 }
 
 bool GraphNode::isGoal() const {
-    vector<vector<int>> goal = getGoalState();
-    return state == goal;
+    return packed == getGoalState();
 }
 
 // Verifica se o puzzle é solucionável
@@ -89,10 +106,10 @@ bool GraphNode::isSolvable() const {
     // Converte para array linear e encontra posição do espaço vazio
     for (int i = 0; i < size; i++) {
         for (int j = 0; j < size; j++) {
-            if (state[i][j] == 0) {
+            if (tileAt(i, j) == 0) {
                 blankRow = i;
             } else {
-                linearState.push_back(state[i][j]);
+                linearState.push_back(tileAt(i, j));
             }
         }
     }
@@ -128,14 +145,14 @@ int GraphNode::calculateManhattanDistance() const {
     
     for (int i = 0; i < size; i++) {
         for (int j = 0; j < size; j++) {
-            if (state[i][j] != 0) {
+            if (tileAt(i, j) != 0) {
                 int targetRow, targetCol;
-                if (state[i][j] == size * size) {
+                if (tileAt(i, j) == size * size) {
                     targetRow = size - 1;
                     targetCol = size - 1;
                 } else {
-                    targetRow = (state[i][j] - 1) / size;
-                    targetCol = (state[i][j] - 1) % size;
+                    targetRow = (tileAt(i, j) - 1) / size;
+                    targetCol = (tileAt(i, j) - 1) % size;
                 }
                 distance += abs(i - targetRow) + abs(j - targetCol);
             }
@@ -145,148 +162,38 @@ int GraphNode::calculateManhattanDistance() const {
     return distance;
 }
 
-// Heurística melhorada: Manhattan + Linear Conflicts
+// Heurística melhorada: o maior entre Manhattan + 2 * conflitos lineares e a
+// walking distance; ambas são admissíveis, então o máximo também é
 int GraphNode::calculateAdvancedHeuristic() const {
     int manhattan = calculateManhattanDistance();
     int linearConflicts = calculateLinearConflicts();
     
-    // Para 15-puzzle, adiciona penalizações extras para melhorar a heurística
-    int penalty = 0;
-    if (size == 4) {
-        // Pattern Database: penaliza padrões conhecidos difíceis
-        penalty += calculateCornerPenalty();
-        penalty += calculateEdgePenalty();
-        
-        // Walking Distance: aproximação da distância real
-        penalty += calculateWalkingDistance();
-    }
-    
-    return manhattan + 2 * linearConflicts + penalty;
-}
-
-// Penaliza tiles nos cantos que estão fora de posição
-int GraphNode::calculateCornerPenalty() const {
-    int penalty = 0;
-    vector<pair<int, int>> corners = {{0,0}, {0,3}, {3,0}, {3,3}};
-    
-    for (auto corner : corners) {
-        int i = corner.first, j = corner.second;
-        if (state[i][j] != 0) {
-            int value = state[i][j];
-            int targetRow = (value - 1) / size;
-            int targetCol = (value - 1) % size;
-            
-            // Se não está no canto correto, penaliza mais
-            if (abs(i - targetRow) + abs(j - targetCol) > 2) {
-                penalty += 2;
-            }
-        }
-    }
-    return penalty;
+    return max(manhattan + 2 * linearConflicts, calculateWalkingDistance());
 }
 
-// Penaliza tiles nas bordas
-int GraphNode::calculateEdgePenalty() const {
-    int penalty = 0;
-    
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            if (state[i][j] != 0) {
-                int value = state[i][j];
-                int targetRow = (value - 1) / size;
-                int targetCol = (value - 1) % size;
-                
-                // Se está na borda mas deveria estar no centro (ou vice-versa)
-                bool currentBorder = (i == 0 || i == size-1 || j == 0 || j == size-1);
-                bool targetBorder = (targetRow == 0 || targetRow == size-1 || targetCol == 0 || targetCol == size-1);
-                
-                if (currentBorder != targetBorder) {
-                    penalty += 1;
-                }
-            }
-        }
-    }
-    return penalty;
-}
-
-// Aproximação da distância real considerando dependências
+// Walking distance exata, consultada na tabela gerada por busca em largura
 int GraphNode::calculateWalkingDistance() const {
-    int distance = 0;
-    
-    // Conta quantos tiles precisam "andar" através de outros
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            if (state[i][j] != 0) {
-                int value = state[i][j];
-                int targetRow = (value - 1) / size;
-                int targetCol = (value - 1) % size;
-                
-                // Se precisa atravessar muitos tiles
-                int manhattanDist = abs(i - targetRow) + abs(j - targetCol);
-                if (manhattanDist > 3) {
-                    distance += manhattanDist / 4; // Penalidade proporcional
-                }
-            }
-        }
+    int tiles[16];
+    for (int c = 0; c < size * size; c++) {
+        tiles[c] = tileAt(c / size, c % size);
     }
-    
-    return distance;
+    return WalkingDistance::forSize(size).evaluate(tiles);
 }
 
+// Conflitos lineares: em cada linha (coluna), o menor número de peças que
+// precisam sair dela para que as demais fiquem na ordem objetivo
 int GraphNode::calculateLinearConflicts() const {
-    int conflicts = 0;
-    
-    // Conflitos nas linhas
-    for (int i = 0; i < size; i++) {
-        vector<int> row;
-        for (int j = 0; j < size; j++) {
-            if (state[i][j] != 0) {
-                int targetRow = (state[i][j] - 1) / size;
-                if (targetRow == i) {
-                    row.push_back(state[i][j]);
-                }
-            }
-        }
-        conflicts += countConflictsInLine(row, i, true);
+    const PuzzleHeuristics& tables = PuzzleHeuristics::forSize(size);
+    int tiles[16];
+    for (int c = 0; c < size * size; c++) {
+        tiles[c] = tileAt(c / size, c % size);
     }
     
-    // Conflitos nas colunas
-    for (int j = 0; j < size; j++) {
-        vector<int> col;
-        for (int i = 0; i < size; i++) {
-            if (state[i][j] != 0) {
-                int targetCol = (state[i][j] - 1) % size;
-                if (targetCol == j) {
-                    col.push_back(state[i][j]);
-                }
-            }
-        }
-        conflicts += countConflictsInLine(col, j, false);
-    }
-    
-    return conflicts;
-}
-
-int GraphNode::countConflictsInLine(const vector<int>& line, int index, bool isRow) const {
     int conflicts = 0;
-    
-    for (int i = 0; i < line.size(); i++) {
-        for (int j = i + 1; j < line.size(); j++) {
-            int pos1, pos2;
-            if (isRow) {
-                pos1 = (line[i] - 1) % size;
-                pos2 = (line[j] - 1) % size;
-            } else {
-                pos1 = (line[i] - 1) / size;
-                pos2 = (line[j] - 1) / size;
-            }
-            
-            if (pos1 > pos2) {
-                conflicts++;
-            }
-        }
+    for (int line = 0; line < size; line++) {
+        conflicts += tables.rowConflicts[line][tables.rowCode(tiles, line)];
+        conflicts += tables.colConflicts[line][tables.colCode(tiles, line)];
     }
-    
     return conflicts;
 }
 
@@ -295,7 +202,7 @@ string GraphNode::toString() const {
     for (int i = 0; i < size; i++) {
         for (int j = 0; j < size; j++) {
             if (j > 0) ss << " ";
-            ss << state[i][j];
+            ss << tileAt(i, j);
         }
         if (i < size - 1) ss << "\\n";
     }
@@ -306,23 +213,23 @@ void GraphNode::print() const {
     for (int i = 0; i < size; i++) {
         for (int j = 0; j < size; j++) {
             if (j > 0) cout << " ";
-            cout << state[i][j];
+            cout << tileAt(i, j);
         }
         cout << endl;
     }
 }
 
 bool GraphNode::operator==(const GraphNode& other) const {
-    return id == other.id;
+    return packed == other.packed;
 }
 
 bool GraphNode::operator<(const GraphNode& other) const {
-    return id < other.id;
+    return packed < other.packed;
 }
 
 // ===== Implementação da classe GraphEdge =====
 
-GraphEdge::GraphEdge(const string& from, const string& to, const string& move, int c)
+GraphEdge::GraphEdge(uint64_t from, uint64_t to, const string& move, int c)
     : fromNodeId(from), toNodeId(to), moveDescription(move), cost(c) {}
 
 // ===== Implementação da classe PuzzleGraph =====
@@ -360,16 +267,16 @@ vector<GraphNode> PuzzleGraph::getNeighbors(const GraphNode& node) {
     return neighbors;
 }
 
-bool PuzzleGraph::hasNode(const string& nodeId) const {
+bool PuzzleGraph::hasNode(uint64_t nodeId) const {
     return nodes.find(nodeId) != nodes.end();
 }
 
-GraphNode PuzzleGraph::getNode(const string& nodeId) const {
+GraphNode PuzzleGraph::getNode(uint64_t nodeId) const {
     auto it = nodes.find(nodeId);
     if (it != nodes.end()) {
         return it->second;
     }
-    throw runtime_error("Nó não encontrado: " + nodeId);
+    throw runtime_error("Nó não encontrado: " + to_string(nodeId));
 }
 
 bool PuzzleGraph::isValidMove(const GraphNode& node, int newRow, int newCol) const {
@@ -378,13 +285,8 @@ bool PuzzleGraph::isValidMove(const GraphNode& node, int newRow, int newCol) con
 }
 
 GraphNode PuzzleGraph::makeMove(const GraphNode& node, int newRow, int newCol) const {
-    vector<vector<int>> newState = node.getState();
-    auto emptyPos = node.getEmptyPosition();
-    
     // Troca a posição vazia com a nova posição
-    swap(newState[emptyPos.first][emptyPos.second], newState[newRow][newCol]);
-    
-    return GraphNode(newState);
+    return node.slide(newRow, newCol);
 }
 
 vector<pair<GraphNode, string>> PuzzleGraph::generateNeighbors(const GraphNode& node) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -8,12 +9,14 @@
 using namespace std;
 
 // Classe para representar um vértice (estado) no grafo
+// O tabuleiro fica compactado em um uint64_t, 4 bits por casa: a casa
+// linha * size + coluna ocupa os bits 4 * casa .. 4 * casa + 3 (3x3 usa 36 bits).
+// O próprio inteiro é o ID do estado, usado para hash e comparação
 class GraphNode {
 private:
-    vector<vector<int>> state;
+    uint64_t packed;
     int size;
-    string id; // ID único para este estado
-    int emptyRow, emptyCol;
+    int emptyPos; // Casa do espaço vazio (linha * size + coluna)
     
 public:
     GraphNode();
@@ -21,10 +24,33 @@ public:
     GraphNode(const vector<vector<int>>& state);
     
     // Getters
-    const vector<vector<int>>& getState() const { return state; }
+    vector<vector<int>> getState() const;
     int getSize() const { return size; }
-    const string& getId() const { return id; }
-    pair<int, int> getEmptyPosition() const { return {emptyRow, emptyCol}; }
+    uint64_t getId() const { return packed; }
+    pair<int, int> getEmptyPosition() const { return {emptyPos / size, emptyPos % size}; }
+    
+    // Peça na casa (row, col), 0 para o espaço vazio
+    int tileAt(int row, int col) const {
+        return (int)((packed >> (4 * (row * size + col))) & 0xF);
+    }
+    
+    // Código da linha row e da coluna col: as peças em nibbles, a primeira casa
+    // nos bits menos significativos (o formato de PuzzleHeuristics)
+    uint32_t rowCode(int row) const {
+        return (uint32_t)(packed >> (4 * row * size)) & ((1u << (4 * size)) - 1);
+    }
+    uint32_t colCode(int col) const {
+        uint32_t code = 0;
+        for (int row = 0; row < size; row++) code |= (uint32_t)tileAt(row, col) << (4 * row);
+        return code;
+    }
+    
+    // Estado após deslizar a peça de (row, col), vizinha ao espaço vazio, para
+    // o espaço: troca de dois nibbles em O(1)
+    GraphNode slide(int row, int col) const;
+    
+    // ID legível no formato "14-13-15-..." (para mensagens)
+    string getLabel() const;
     
     // Métodos principais
     bool isGoal() const;
@@ -39,37 +65,33 @@ public:
     bool operator<(const GraphNode& other) const;
     
 private:
-    void findEmptyPosition();
-    void generateId();
-    vector<vector<int>> getGoalState() const;
+    void pack(const vector<int>& tiles);
+    uint64_t getGoalState() const;
     int calculateLinearConflicts() const;
-    int countConflictsInLine(const vector<int>& line, int index, bool isRow) const;
-    int calculateCornerPenalty() const;
-    int calculateEdgePenalty() const;
     int calculateWalkingDistance() const;
 };
 
 // Hash para usar GraphNode em unordered containers
 struct GraphNodeHash {
     size_t operator()(const GraphNode& node) const {
-        return hash<string>{}(node.getId());
+        return hash<uint64_t>{}(node.getId());
     }
 };
 
 // Classe para representar uma aresta no grafo
 class GraphEdge {
 private:
-    string fromNodeId;
-    string toNodeId;
+    uint64_t fromNodeId;
+    uint64_t toNodeId;
     string moveDescription;
     int cost;
     
 public:
-    GraphEdge(const string& from, const string& to, const string& move, int c = 1);
+    GraphEdge(uint64_t from, uint64_t to, const string& move, int c = 1);
     
     // Getters
-    const string& getFromNodeId() const { return fromNodeId; }
-    const string& getToNodeId() const { return toNodeId; }
+    uint64_t getFromNodeId() const { return fromNodeId; }
+    uint64_t getToNodeId() const { return toNodeId; }
     const string& getMoveDescription() const { return moveDescription; }
     int getCost() const { return cost; }
 };
@@ -77,8 +99,8 @@ public:
 // Classe principal do grafo para o puzzle
 class PuzzleGraph {
 private:
-    unordered_map<string, GraphNode> nodes;
-    unordered_map<string, vector<GraphEdge>> adjacencyList;
+    unordered_map<uint64_t, GraphNode> nodes;
+    unordered_map<uint64_t, vector<GraphEdge>> adjacencyList;
     
 public:
     PuzzleGraph();
@@ -89,8 +111,8 @@ public:
     
     // Busca e navegação
     vector<GraphNode> getNeighbors(const GraphNode& node);
-    bool hasNode(const string& nodeId) const;
-    GraphNode getNode(const string& nodeId) const;
+    bool hasNode(uint64_t nodeId) const;
+    GraphNode getNode(uint64_t nodeId) const;
     
     // Método para gerar vizinhos dinamicamente (sem pré-construir todo o grafo)
     vector<pair<GraphNode, string>> generateNeighbors(const GraphNode& node);
@@ -0,0 +1,103 @@
+#include "PuzzleHeuristics.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+PuzzleHeuristics::PuzzleHeuristics(int size) : size(size) {
+    int cells = size * size;
+
+    // A peça t (1..cells-1) tem objetivo na casa t - 1; o espaço vazio não conta
+    for (int t = 0; t < 16; t++) {
+        for (int c = 0; c < 16; c++) {
+            manhattan[t][c] = 0;
+            if (t == 0 || t >= cells || c >= cells) continue;
+            int goal = t - 1;
+            manhattan[t][c] = abs(c / size - goal / size) + abs(c % size - goal % size);
+        }
+    }
+    for (int t = 0; t < 16; t++) {
+        for (int a = 0; a < 16; a++) {
+            for (int b = 0; b < 16; b++) {
+                manhattanDelta[t][a][b] = manhattan[t][b] - manhattan[t][a];
+            }
+        }
+    }
+
+    uint32_t codes = 1u << (4 * size);
+    for (int line = 0; line < size; line++) {
+        rowConflicts[line].resize(codes);
+        colConflicts[line].resize(codes);
+        for (uint32_t code = 0; code < codes; code++) {
+            rowConflicts[line][code] = lineConflicts(code, line, true);
+            colConflicts[line][code] = lineConflicts(code, line, false);
+        }
+    }
+}
+
+const PuzzleHeuristics& PuzzleHeuristics::forSize(int size) {
+    static const PuzzleHeuristics small(3);
+    static const PuzzleHeuristics large(4);
+    if (size == 3) return small;
+    if (size == 4) return large;
+    throw invalid_argument("Tamanho de puzzle sem tabelas: " + to_string(size));
+}
+
+int PuzzleHeuristics::lineConflicts(uint32_t code, int index, bool isRow) const {
+    // Posições objetivo (ao longo da linha) das peças que já estão na linha
+    // objetivo, na ordem em que aparecem
+    int targets[4];
+    int count = 0;
+    for (int k = 0; k < size; k++) {
+        int t = (code >> (4 * k)) & 0xF;
+        if (t == 0 || t >= size * size) continue;
+        int goal = t - 1;
+        if (isRow && goal / size == index) {
+            targets[count++] = goal % size;
+        } else if (!isRow && goal % size == index) {
+            targets[count++] = goal / size;
+        }
+    }
+
+    // Maior subsequência crescente: as peças fora dela precisam sair da linha
+    int longest[4];
+    int best = 0;
+    for (int i = 0; i < count; i++) {
+        longest[i] = 1;
+        for (int j = 0; j < i; j++) {
+            if (targets[j] < targets[i]) longest[i] = max(longest[i], longest[j] + 1);
+        }
+        best = max(best, longest[i]);
+    }
+    return count - best;
+}
+
+uint32_t PuzzleHeuristics::rowCode(const int* tiles, int row) const {
+    uint32_t code = 0;
+    for (int k = 0; k < size; k++) {
+        code |= (uint32_t)tiles[row * size + k] << (4 * k);
+    }
+    return code;
+}
+
+uint32_t PuzzleHeuristics::colCode(const int* tiles, int col) const {
+    uint32_t code = 0;
+    for (int k = 0; k < size; k++) {
+        code |= (uint32_t)tiles[k * size + col] << (4 * k);
+    }
+    return code;
+}
+
+int PuzzleHeuristics::evaluate(const int* tiles) const {
+    int distance = 0;
+    for (int c = 0; c < size * size; c++) {
+        distance += manhattan[tiles[c]][c];
+    }
+
+    int conflicts = 0;
+    for (int line = 0; line < size; line++) {
+        conflicts += rowConflicts[line][rowCode(tiles, line)];
+        conflicts += colConflicts[line][colCode(tiles, line)];
+    }
+    return distance + 2 * conflicts;
+}
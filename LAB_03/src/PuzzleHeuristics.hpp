@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Tabelas das heurísticas admissíveis do puzzle, calculadas uma vez por
+// tamanho e consultadas em O(1) durante a busca:
+//
+//   manhattan[t][c]   distância de Manhattan da peça t na casa c até o seu objetivo
+//   manhattanDelta[t][a][b]  variação de Manhattan quando a peça t vai da casa a para b
+//   rowConflicts[r]   conflitos lineares da linha r, indexados pelo código da linha
+//   colConflicts[c]   idem para a coluna c
+//
+// O código de uma linha (ou coluna) são as suas peças em nibbles, na ordem das
+// casas (a primeira casa nos 4 bits menos significativos). Os conflitos de uma
+// linha são o menor número de peças que precisam sair dela para que as demais,
+// já na linha objetivo, fiquem em ordem: cada uma custa 2 movimentos além de
+// Manhattan, então Manhattan + 2 * conflitos continua admissível.
+class PuzzleHeuristics {
+public:
+    int size;
+    uint8_t manhattan[16][16];
+    int8_t manhattanDelta[16][16][16];
+    vector<uint8_t> rowConflicts[4];
+    vector<uint8_t> colConflicts[4];
+
+    // Tabelas do tamanho pedido (3 ou 4), montadas na primeira chamada
+    static const PuzzleHeuristics& forSize(int size);
+
+    // Código da linha row e da coluna col de um tabuleiro linear
+    uint32_t rowCode(const int* tiles, int row) const;
+    uint32_t colCode(const int* tiles, int col) const;
+
+    // Manhattan + 2 * conflitos lineares calculados do zero
+    int evaluate(const int* tiles) const;
+
+private:
+    explicit PuzzleHeuristics(int size);
+
+    // Conflitos de uma linha cujas peças estão em code; isRow indica se é
+    // linha (peças comparadas pela coluna objetivo) ou coluna
+    int lineConflicts(uint32_t code, int index, bool isRow) const;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Tabela hash de endereçamento aberto (sondagem linear) do estado compactado
+// (GraphNode::getId) para o índice do vértice na arena da busca. Chaves e
+// valores ficam em dois vetores contíguos, 12 bytes por casa, sem alocação por
+// inserção. A chave 0 marca casa vazia: nenhum tabuleiro válido é todo zero.
+// Não há remoção; a capacidade dobra quando a ocupação passa de 70%.
+class StateTable {
+public:
+    static const uint32_t MISSING = UINT32_MAX;
+
+    explicit StateTable(size_t expected = 1024) : count(0) {
+        size_t capacity = 16;
+        while (capacity * 7 < expected * 10) capacity *= 2;
+        resize(capacity);
+    }
+
+    // Valor associado a key ou, se ausente, insere key com value e retorna MISSING
+    uint32_t findOrInsert(uint64_t key, uint32_t value) {
+        if ((count + 1) * 10 > keys.size() * 7) resize(keys.size() * 2);
+        size_t mask = keys.size() - 1;
+        for (size_t i = slot(key);; i = (i + 1) & mask) {
+            if (keys[i] == key) return values[i];
+            if (keys[i] == 0) {
+                keys[i] = key;
+                values[i] = value;
+                count++;
+                return MISSING;
+            }
+        }
+    }
+
+    size_t size() const { return count; }
+
+private:
+    vector<uint64_t> keys;
+    vector<uint32_t> values;
+    size_t count;
+    int shift;
+
+    // Hash multiplicativo (Fibonacci): os bits altos do produto indexam a tabela
+    size_t slot(uint64_t key) const {
+        return (size_t)((key * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    void resize(size_t capacity) {
+        vector<uint64_t> oldKeys(capacity, 0);
+        vector<uint32_t> oldValues(capacity);
+        oldKeys.swap(keys);
+        oldValues.swap(values);
+        shift = 64;
+        for (size_t c = capacity; c > 1; c >>= 1) shift--;
+
+        size_t mask = capacity - 1;
+        for (size_t j = 0; j < oldKeys.size(); j++) {
+            if (oldKeys[j] == 0) continue;
+            size_t i = slot(oldKeys[j]);
+            while (keys[i] != 0) i = (i + 1) & mask;
+            keys[i] = oldKeys[j];
+            values[i] = oldValues[j];
+        }
+    }
+};
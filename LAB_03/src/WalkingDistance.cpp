@@ -0,0 +1,155 @@
+#include "WalkingDistance.hpp"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+static const char MAGIC[4] = {'G', 'P', 'W', 'D'};
+
+// Tabelas já montadas ou carregadas, por tamanho
+static unique_ptr<WalkingDistance>& slot(int size) {
+    static unique_ptr<WalkingDistance> tables[5];
+    if (size != 3 && size != 4) {
+        throw invalid_argument("Tamanho de puzzle sem tabelas: " + to_string(size));
+    }
+    return tables[size];
+}
+
+WalkingDistance::WalkingDistance(int size) : size(size) {
+    // Objetivo: cada linha com as suas peças e o espaço vazio na última
+    uint64_t goal = 0;
+    for (int r = 0; r < size; r++) {
+        goal += (uint64_t)(r == size - 1 ? size - 1 : size) << (3 * (r * size + r));
+    }
+    codes.push_back(goal);
+    distance.push_back(0);
+    indexOf[goal] = 0;
+
+    // Busca em largura usando codes como fila; as transições de cada estado
+    // são gravadas na ordem de step
+    for (size_t i = 0; i < codes.size(); i++) {
+        uint64_t code = codes[i];
+        int blank = 0;
+        for (int r = 0; r < size; r++) {
+            int tiles = 0;
+            for (int g = 0; g < size; g++) tiles += counter(code, r, g);
+            if (tiles == size - 1) blank = r;
+        }
+
+        for (int direction = 0; direction < 2; direction++) {
+            int from = direction == 0 ? blank - 1 : blank + 1;
+            for (int g = 0; g < size; g++) {
+                int target = -1;
+                if (from >= 0 && from < size && counter(code, from, g) > 0) {
+                    uint64_t moved = code - (1ull << (3 * (from * size + g))) +
+                                     (1ull << (3 * (blank * size + g)));
+                    auto it = indexOf.find(moved);
+                    if (it == indexOf.end()) {
+                        target = codes.size();
+                        indexOf[moved] = target;
+                        codes.push_back(moved);
+                        distance.push_back(distance[i] + 1);
+                    } else {
+                        target = it->second;
+                    }
+                }
+                next.push_back(target);
+            }
+        }
+    }
+}
+
+const WalkingDistance& WalkingDistance::forSize(int size) {
+    unique_ptr<WalkingDistance>& table = slot(size);
+    if (!table) table.reset(new WalkingDistance(size));
+    return *table;
+}
+
+void WalkingDistance::save(const string& path) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) throw runtime_error("Não foi possível criar o arquivo " + path);
+
+    int32_t count = 2;
+    bool ok = fwrite(MAGIC, 1, sizeof(MAGIC), file) == sizeof(MAGIC) &&
+              fwrite(&count, sizeof(count), 1, file) == 1;
+    for (int size = 3; ok && size <= 4; size++) {
+        const WalkingDistance& table = forSize(size);
+        int32_t header[2] = {size, (int32_t)table.codes.size()};
+        ok = fwrite(header, sizeof(int32_t), 2, file) == 2 &&
+             fwrite(table.codes.data(), sizeof(uint64_t), table.codes.size(), file) == table.codes.size() &&
+             fwrite(table.distance.data(), 1, table.distance.size(), file) == table.distance.size() &&
+             fwrite(table.next.data(), sizeof(int32_t), table.next.size(), file) == table.next.size();
+    }
+
+    if (fclose(file) != 0 || !ok) {
+        throw runtime_error("Erro ao gravar o arquivo " + path);
+    }
+}
+
+void WalkingDistance::load(const string& path) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) throw runtime_error("Não foi possível abrir o arquivo " + path);
+
+    char magic[4];
+    int32_t count = 0;
+    bool valid = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                 memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 fread(&count, sizeof(count), 1, file) == 1 && count >= 0 && count <= 2;
+
+    // As tabelas só são instaladas depois que o arquivo inteiro for validado
+    vector<unique_ptr<WalkingDistance>> tables;
+    for (int32_t k = 0; valid && k < count; k++) {
+        int32_t header[2];
+        valid = fread(header, sizeof(int32_t), 2, file) == 2 &&
+                (header[0] == 3 || header[0] == 4) && header[1] > 0 && header[1] <= (1 << 20);
+        if (!valid) break;
+
+        unique_ptr<WalkingDistance> table(new WalkingDistance());
+        table->size = header[0];
+        int32_t states = header[1];
+        table->codes.resize(states);
+        table->distance.resize(states);
+        table->next.resize((size_t)states * 2 * table->size);
+        valid = fread(table->codes.data(), sizeof(uint64_t), states, file) == (size_t)states &&
+                fread(table->distance.data(), 1, states, file) == (size_t)states &&
+                fread(table->next.data(), sizeof(int32_t), table->next.size(), file) == table->next.size();
+        for (int32_t target : table->next) {
+            valid = valid && target >= -1 && target < states;
+        }
+        for (int32_t i = 0; valid && i < states; i++) {
+            valid = table->indexOf.emplace(table->codes[i], i).second;
+        }
+        tables.push_back(move(table));
+    }
+    fclose(file);
+
+    if (!valid) throw runtime_error("Tabela de walking distance inválida: " + path);
+    for (unique_ptr<WalkingDistance>& table : tables) {
+        int size = table->size;
+        slot(size) = move(table);
+    }
+}
+
+int WalkingDistance::lookup(uint64_t code) const {
+    auto it = indexOf.find(code);
+    if (it == indexOf.end()) throw runtime_error("Estado sem walking distance");
+    return it->second;
+}
+
+int WalkingDistance::rowIndex(const int* tiles) const {
+    uint64_t code = 0;
+    for (int c = 0; c < size * size; c++) {
+        if (tiles[c] == 0) continue;
+        code += 1ull << (3 * ((c / size) * size + (tiles[c] - 1) / size));
+    }
+    return lookup(code);
+}
+
+int WalkingDistance::colIndex(const int* tiles) const {
+    uint64_t code = 0;
+    for (int c = 0; c < size * size; c++) {
+        if (tiles[c] == 0) continue;
+        code += 1ull << (3 * ((c % size) * size + (tiles[c] - 1) % size));
+    }
+    return lookup(code);
+}
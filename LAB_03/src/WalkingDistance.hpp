@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// Walking distance (Takahashi): considera só em que linha cada peça está e a
+// linha objetivo dela. O estado é a matriz counts[r][g] = número de peças na
+// linha r com objetivo na linha g, mais a linha do espaço vazio; um movimento
+// vertical leva uma peça da linha vizinha para a linha do espaço. A busca em
+// largura a partir do objetivo dá o menor número de movimentos verticais para
+// cada matriz. As colunas formam o mesmo problema (transposto), então a mesma
+// tabela serve para os movimentos horizontais e a soma das duas é admissível.
+//
+// A matriz fica em 3 bits por contador (code). Os estados são numerados na
+// ordem da busca e step dá o estado seguinte em O(1), então a busca mantém os
+// índices de linhas e colunas a cada movimento sem recalcular a matriz.
+class WalkingDistance {
+public:
+    int size;
+    vector<uint64_t> codes;     // Matriz de cada estado
+    vector<uint8_t> distance;   // Movimentos até o objetivo
+    vector<int32_t> next;       // Transições (ver step); -1 se inválida
+
+    // Tabela do tamanho pedido (3 ou 4): a carregada por load, se houver, ou
+    // gerada por busca em largura na primeira chamada
+    static const WalkingDistance& forSize(int size);
+
+    // Grava as tabelas de 3x3 e 4x4 (cerca de 1 MB) e carrega um arquivo
+    // gravado por save; lançam runtime_error em caso de erro
+    static void save(const string& path);
+    static void load(const string& path);
+
+    // Estado após o espaço vazio sair da linha atual para a de cima
+    // (direction 0) ou de baixo (direction 1) trazendo uma peça com objetivo
+    // na linha goal
+    int step(int index, int direction, int goal) const {
+        return next[(index * 2 + direction) * size + goal];
+    }
+
+    // Índice do estado das linhas (rowIndex) ou das colunas (colIndex) de um
+    // tabuleiro linear
+    int rowIndex(const int* tiles) const;
+    int colIndex(const int* tiles) const;
+
+    // Walking distance calculada do zero
+    int evaluate(const int* tiles) const {
+        return distance[rowIndex(tiles)] + distance[colIndex(tiles)];
+    }
+
+private:
+    unordered_map<uint64_t, int> indexOf;
+
+    WalkingDistance() : size(0) {}
+    explicit WalkingDistance(int size);
+
+    int counter(uint64_t code, int row, int goal) const {
+        return (code >> (3 * (row * size + goal))) & 7;
+    }
+    int lookup(uint64_t code) const;
+};
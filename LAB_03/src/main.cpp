@@ -1,10 +1,14 @@
 #include "GraphAStar.hpp"
+#include "GraphIDAStar.hpp"
+#include "PatternDatabase.hpp"
+#include "WalkingDistance.hpp"
 #include "PuzzleGraph.hpp"
+#include "fast-input.hpp"
 #include <iostream>
 #include <vector>
-#include <fstream>
-#include <sstream>
 #include <iomanip>
+#include <sstream>
+#include <stdexcept>
 #include <streambuf>
 
 using namespace std;
@@ -13,7 +17,8 @@ vector<int> readInput() {
     vector<int> input;
     string line;
     
-    // Lê uma linha de entrada
+    // Lê só a primeira linha da entrada padrão (com getline, para que o uso
+    // interativo não espere o fim da entrada)
     if (getline(cin, line)) {
         istringstream iss(line);
         int number;
@@ -22,6 +27,9 @@ vector<int> readInput() {
         while (iss >> number) {
             input.push_back(number);
         }
+        if (!iss.eof()) {
+            throw runtime_error("Token inválido na entrada: " + line);
+        }
     }
     
     return input;
@@ -29,59 +37,76 @@ vector<int> readInput() {
 
 vector<int> readInputFromFile(const string& filename) {
     vector<int> input;
-    ifstream file(filename);
+    FastInput reader(filename);
     
-    if (!file.is_open()) {
+    if (!reader.good()) {
         cerr << "Erro: Não foi possível abrir o arquivo " << filename << endl;
         return input;
     }
     
-    string line;
-    if (getline(file, line)) {
-        istringstream iss(line);
-        int number;
-        
-        while (iss >> number) {
-            input.push_back(number);
-        }
+    if (!reader.nextLine(input) && reader.failed()) {
+        throw runtime_error("Token inválido em " + filename + " (byte " +
+                            to_string(reader.offset()) + ")");
     }
-    
-    file.close();
     return input;
 }
 
+// Resultado de uma instância, qualquer que seja o solver
+struct SolveResult {
+    vector<GraphNode> solution;
+    double time;
+    long long statesEvaluated;
+    long long statesEnqueued;
+};
+
+// Resolve com o A* ou, se useIda, com o IDA* (com o banco de padrões, se
+// carregado); as estatísticas vão para a saída de erro quando printStats
+SolveResult solvePuzzle(const GraphNode& initial, bool useIda, const PatternDatabase& patterns,
+                        bool printStats) {
+    SolveResult result;
+    if (useIda) {
+        GraphIDAStar solver(&patterns);
+        result.solution = solver.solveSilent(initial);
+        result.time = solver.getExecutionTime();
+        result.statesEvaluated = solver.getStatesEvaluated();
+        result.statesEnqueued = solver.getStatesGenerated();
+        if (printStats) solver.printStatistics();
+    } else {
+        GraphAStar solver;
+        result.solution = solver.solveSilent(initial);
+        result.time = solver.getExecutionTime();
+        result.statesEvaluated = solver.getStatesEvaluated();
+        result.statesEnqueued = solver.getStatesEnqueued();
+        if (printStats) solver.printStatistics();
+    }
+    return result;
+}
+
 // Nova função para processar múltiplas instâncias
-void processBatchFile(const string& filename) {
-    ifstream file(filename);
+void processBatchFile(const string& filename, bool useIda, const PatternDatabase& patterns) {
+    FastInput reader(filename);
     
-    if (!file.is_open()) {
+    if (!reader.good()) {
         cerr << "Erro: Não foi possível abrir o arquivo " << filename << endl;
         return;
     }
     
-    string line;
+    vector<int> input;
     int instanceCount = 0;
     double totalTime = 0.0;
-    int totalStatesEvaluated = 0;
-    int totalStatesEnqueued = 0;
+    long long totalStatesEvaluated = 0;
+    long long totalStatesEnqueued = 0;
     int solvedCount = 0;
     int unsolvableCount = 0;
     
     cout << "=== PROCESSAMENTO EM LOTE DE INSTÂNCIAS PUZZLE ===" << endl;
     cout << "Arquivo: " << filename << endl << endl;
     
-    while (getline(file, line)) {
-        if (line.empty()) continue;
+    // Cada linha da entrada é uma instância
+    while (reader.nextLine(input)) {
+        if (input.empty()) continue;
         
         instanceCount++;
-        vector<int> input;
-        istringstream iss(line);
-        int number;
-        
-        // Lê números da linha
-        while (iss >> number) {
-            input.push_back(number);
-        }
         
         if (input.size() != 9 && input.size() != 16) {
             cout << "Instância " << instanceCount << ": FORMATO INVÁLIDO (esperado 9 ou 16 números)" << endl;
@@ -99,22 +124,20 @@ void processBatchFile(const string& filename) {
                 continue;
             }
             
-            // Cria o solver A*
-            GraphAStar solver;
-            
             // Resolve o puzzle (modo silencioso para lote)
-            vector<GraphNode> solution = solver.solveSilent(initialPuzzle);
+            SolveResult result = solvePuzzle(initialPuzzle, useIda, patterns, false);
+            const vector<GraphNode>& solution = result.solution;
             
             if (!solution.empty()) {
                 cout << "Instância " << instanceCount << ": RESOLVIDA em " 
                      << (solution.size() - 1) << " passos | "
-                     << "Tempo: " << fixed << setprecision(6) << solver.getExecutionTime() << "s | "
-                     << "Vértices: " << solver.getStatesEvaluated() << " | "
-                     << "Enfileirados: " << solver.getStatesEnqueued() << endl;
+                     << "Tempo: " << fixed << setprecision(6) << result.time << "s | "
+                     << "Vértices: " << result.statesEvaluated << " | "
+                     << "Enfileirados: " << result.statesEnqueued << endl;
                 
-                totalTime += solver.getExecutionTime();
-                totalStatesEvaluated += solver.getStatesEvaluated();
-                totalStatesEnqueued += solver.getStatesEnqueued();
+                totalTime += result.time;
+                totalStatesEvaluated += result.statesEvaluated;
+                totalStatesEnqueued += result.statesEnqueued;
                 solvedCount++;
             } else {
                 cout << "Instância " << instanceCount << ": FALHA NA RESOLUÇÃO" << endl;
@@ -125,7 +148,11 @@ void processBatchFile(const string& filename) {
         }
     }
     
-    file.close();
+    // Um token inválido interrompe o lote: as linhas seguintes não são lidas
+    if (reader.failed()) {
+        cerr << "Erro: Token inválido em " << filename << " (byte " << reader.offset()
+             << "); instâncias seguintes ignoradas" << endl;
+    }
     
     // Estatísticas finais
     cout << endl << "=== ESTATÍSTICAS FINAIS ===" << endl;
@@ -164,74 +191,85 @@ void printSolution(const vector<GraphNode>& solution) {
 
 int main(int argc, char* argv[]) {
     try {
-        // Verifica se foi passado argumento de linha de comando
-        if (argc > 1) {
-            string filename = argv[1];
-            
-            // Verifica se é o modo em lote (arquivo com múltiplas instâncias)
-            if (argc > 2 && string(argv[2]) == "--batch") {
-                processBatchFile(filename);
-                return 0;
-            }
-            
-            // Modo single - processa apenas uma instância do arquivo
-            vector<int> input = readInputFromFile(filename);
-            
-            // Verifica se a entrada é válida
-            if (input.size() != 9 && input.size() != 16) {
-                cerr << "Erro: Entrada deve conter 9 números (8-puzzle) ou 16 números (15-puzzle)" << endl;
-                return 1;
-            }
-            
-            // Cria o nó inicial do grafo
-            GraphNode initialNode(input);
-            
-            // Cria o solver A* orientado a grafos
-            GraphAStar solver;
-            
-            // Resolve o puzzle usando busca no grafo (modo silencioso)
-            vector<GraphNode> solution = solver.solveSilent(initialNode);
-            
-            // Imprime as estatísticas obrigatórias na saída de erro (conforme enunciado)
-            solver.printStatistics();
-            
-            // Imprime APENAS a solução na saída padrão (conforme enunciado)
-            printSolution(solution);
-            
-            if (solution.empty()) {
-                return 1; // Indica que não foi encontrada solução
-            }
-            
-        } else {
-            // Modo stdin - lê da entrada padrão
-            vector<int> input = readInput();
-            
-            // Verifica se a entrada é válida
-            if (input.size() != 9 && input.size() != 16) {
-                cerr << "Erro: Entrada deve conter 9 números (8-puzzle) ou 16 números (15-puzzle)" << endl;
-                return 1;
-            }
-            
-            // Cria o nó inicial do grafo
-            GraphNode initialNode(input);
-            
-            // Cria o solver A* orientado a grafos
-            GraphAStar solver;
-            
-            // Resolve o puzzle usando busca no grafo (modo silencioso)
-            vector<GraphNode> solution = solver.solveSilent(initialNode);
-            
-            // Imprime as estatísticas obrigatórias na saída de erro (conforme enunciado)
-            solver.printStatistics();
-            
-            // Imprime APENAS a solução na saída padrão (conforme enunciado)
-            printSolution(solution);
-            
-            if (solution.empty()) {
-                return 1; // Indica que não foi encontrada solução
+        // Argumentos: [arquivo] [--batch] [--ida] [--pdb <banco>] [--build-pdb <banco>]
+        //            [--wd <tabela>] [--build-wd <tabela>]
+        // --batch trata cada linha do arquivo como uma instância e --ida usa o
+        // IDA* (memória constante, solução ótima) em vez do A*. --pdb mapeia um
+        // banco de padrões 6-6-3 usado pelo IDA* no 15-puzzle (implica --ida) e
+        // --build-pdb gera esse banco e termina. --wd carrega as tabelas de
+        // walking distance (sem ele, são geradas na primeira instância) e
+        // --build-wd as grava e termina
+        string filename;
+        string patternPath;
+        string buildPath;
+        string walkingPath;
+        string buildWalkingPath;
+        bool batch = false;
+        bool useIda = false;
+        for (int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            if (arg == "--batch") {
+                batch = true;
+            } else if (arg == "--ida") {
+                useIda = true;
+            } else if ((arg == "--pdb" || arg == "--build-pdb") && i + 1 < argc) {
+                (arg == "--pdb" ? patternPath : buildPath) = argv[++i];
+            } else if ((arg == "--wd" || arg == "--build-wd") && i + 1 < argc) {
+                (arg == "--wd" ? walkingPath : buildWalkingPath) = argv[++i];
+            } else {
+                filename = arg;
             }
         }
         
+        if (!buildPath.empty()) {
+            PatternDatabase::build(PatternDatabase::DEFAULT_PARTITION, buildPath);
+            cerr << "Banco de padrões gravado em " << buildPath << endl;
+            return 0;
+        }
+        if (!buildWalkingPath.empty()) {
+            WalkingDistance::save(buildWalkingPath);
+            cerr << "Tabelas de walking distance gravadas em " << buildWalkingPath << endl;
+            return 0;
+        }
+        
+        if (!walkingPath.empty()) {
+            WalkingDistance::load(walkingPath);
+        }
+        PatternDatabase patterns;
+        if (!patternPath.empty()) {
+            patterns.load(patternPath);
+            useIda = true;
+        }
+        
+        // Verifica se é o modo em lote (arquivo com múltiplas instâncias)
+        if (batch && !filename.empty()) {
+            processBatchFile(filename, useIda, patterns);
+            return 0;
+        }
+        
+        // Modo single - processa apenas uma instância do arquivo ou da entrada padrão
+        vector<int> input = filename.empty() ? readInput() : readInputFromFile(filename);
+        
+        // Verifica se a entrada é válida
+        if (input.size() != 9 && input.size() != 16) {
+            cerr << "Erro: Entrada deve conter 9 números (8-puzzle) ou 16 números (15-puzzle)" << endl;
+            return 1;
+        }
+        
+        // Cria o nó inicial do grafo
+        GraphNode initialNode(input);
+        
+        // Resolve o puzzle usando busca no grafo (modo silencioso) e imprime as
+        // estatísticas obrigatórias na saída de erro (conforme enunciado)
+        SolveResult result = solvePuzzle(initialNode, useIda, patterns, true);
+        
+        // Imprime APENAS a solução na saída padrão (conforme enunciado)
+        printSolution(result.solution);
+        
+        if (result.solution.empty()) {
+            return 1; // Indica que não foi encontrada solução
+        }
+        
     } catch (const exception& e) {
         cerr << "Erro: " << e.what() << endl;
         return 1;
@@ -10,6 +10,7 @@ using namespace std;
 FluxoCustoMinimo::FluxoCustoMinimo(Grafo &grafo) : grafo(grafo) {}
 
 // Método principal que executa o algoritmo.
+template <typename Fila>
 pair<int, int> FluxoCustoMinimo::executar(int fonte, int sorvedouro)
 {
     int fluxo_maximo = 0;
@@ -17,8 +18,11 @@ pair<int, int> FluxoCustoMinimo::executar(int fonte, int sorvedouro)
     // Inicializa os potenciais de todos os vértices com 0.
     potencial.assign(grafo.obter_numero_vertices(), 0);
 
+    // Fila do Dijkstra, reaproveitada em todas as iterações.
+    Fila fila_prioridade;
+
     // Loop principal: continua enquanto Dijkstra encontrar um caminho aumentante de menor custo.
-    while (dijkstra(fonte, sorvedouro))
+    while (dijkstra(fonte, sorvedouro, fila_prioridade))
     {
         // Após encontrar um caminho, atualiza os potenciais dos vértices.
         // Isso é crucial para manter os custos das arestas não-negativos nas próximas iterações.
@@ -53,8 +57,35 @@ pair<int, int> FluxoCustoMinimo::executar(int fonte, int sorvedouro)
     return {fluxo_maximo, custo_minimo};
 }
 
+// Instâncias das políticas de fila disponíveis.
+template pair<int, int> FluxoCustoMinimo::executar<BinaryHeapQueue>(int, int);
+template pair<int, int> FluxoCustoMinimo::executar<RadixHeap>(int, int);
+template pair<int, int> FluxoCustoMinimo::executar<DialQueue>(int, int);
+template pair<int, int> FluxoCustoMinimo::executar<IndexedHeapQueue>(int, int);
+
+// Percorre as arestas residuais com capacidade e retorna o maior custo reduzido.
+// Custos negativos só aparecem em arestas que saem de vértices inalcançáveis
+// (potenciais desatualizados) e são ignorados.
+unsigned int FluxoCustoMinimo::maior_custo_reduzido() const
+{
+    int maior = 0;
+    for (int u = 0; u < grafo.obter_numero_vertices(); ++u)
+    {
+        for (const Aresta &aresta : grafo[u])
+        {
+            if (aresta.capacidade - aresta.fluxo > 0)
+            {
+                maior = max(maior, aresta.custo + potencial[u] - potencial[aresta.para]);
+            }
+        }
+    }
+    return (unsigned int)maior;
+}
+
 // Implementação do Dijkstra com potenciais.
-bool FluxoCustoMinimo::dijkstra(int fonte, int sorvedouro)
+// Os custos reduzidos não são negativos, então as filas monotônicas servem.
+template <typename Fila>
+bool FluxoCustoMinimo::dijkstra(int fonte, int sorvedouro, Fila &fila_prioridade)
 {
     distancia.assign(grafo.obter_numero_vertices(), numeric_limits<int>::max());
     pai_vertice.assign(grafo.obter_numero_vertices(), -1);
@@ -62,18 +93,17 @@ bool FluxoCustoMinimo::dijkstra(int fonte, int sorvedouro)
     distancia[fonte] = 0;
 
     // Fila de prioridade para o Dijkstra: armazena {distância, vértice}.
-    using Estado = pair<int, int>;
-    priority_queue<Estado, vector<Estado>, greater<Estado>> fila_prioridade;
-    fila_prioridade.push({0, fonte});
+    fila_prioridade.reset(Fila::needsMaxStep ? maior_custo_reduzido() : 0);
+    fila_prioridade.push(0, fonte);
 
     while (!fila_prioridade.empty())
     {
-        auto [dist_atual, vertice_atual] = fila_prioridade.top();
-        fila_prioridade.pop();
+        auto [chave, vertice_atual] = fila_prioridade.pop();
+        int dist_atual = (int)chave;
 
         if (dist_atual > distancia[vertice_atual])
         {
-            continue; // Otimização: já encontramos um caminho melhor para este vértice.
+            continue; // Entrada desatualizada (só ocorre nas filas preguiçosas, não no heap indexado).
         }
 
         // Explora os vizinhos do vértice atual.
@@ -90,7 +120,7 @@ bool FluxoCustoMinimo::dijkstra(int fonte, int sorvedouro)
                 distancia[aresta.para] = distancia[vertice_atual] + custo_reduzido;
                 pai_vertice[aresta.para] = vertice_atual;
                 pai_aresta[aresta.para] = i;
-                fila_prioridade.push({distancia[aresta.para], aresta.para});
+                fila_prioridade.push((unsigned int)distancia[aresta.para], aresta.para);
             }
         }
     }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Grafo.hpp"
+#include "dijkstra-queues.hpp" // Políticas de fila de prioridade para o Dijkstra
 #include <vector>
 #include <utility> // Para pair
 
@@ -15,6 +16,12 @@ public:
 
     // Executa o algoritmo para encontrar o fluxo de custo mínimo da fonte 's' ao sorvedouro 't'.
     // Retorna um par contendo {fluxo máximo, custo mínimo}.
+    // Fila escolhe, em tempo de compilação, a fila de prioridade do Dijkstra
+    // (RadixHeap, DialQueue, IndexedHeapQueue ou BinaryHeapQueue). Os custos
+    // da entrada são naturais, então os custos reduzidos das arestas que o
+    // Dijkstra relaxa nunca são negativos e as filas monotônicas servem; o
+    // padrão é o radix heap, o mais rápido nas medições.
+    template <typename Fila = RadixHeap>
     pair<int, int> executar(int fonte, int sorvedouro);
 
     // Após a execução do algoritmo, retorna os vértices que compõem o lado da fonte (s) no corte mínimo.
@@ -31,5 +38,10 @@ private:
 
     // Algoritmo de Dijkstra com potenciais para encontrar o caminho mais curto (menor custo)
     // no grafo residual. Retorna 'true' se um caminho for encontrado, 'false' caso contrário.
-    bool dijkstra(int fonte, int sorvedouro);
+    // A fila é reaproveitada entre as iterações.
+    template <typename Fila>
+    bool dijkstra(int fonte, int sorvedouro, Fila &fila_prioridade);
+
+    // Maior custo reduzido entre as arestas residuais (janela da fila de Dial).
+    unsigned int maior_custo_reduzido() const;
 };
\ No newline at end of file
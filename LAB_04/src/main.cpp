@@ -8,6 +8,7 @@
 
 #include "Grafo.hpp"           // Inclui a definição da nossa classe de Grafo
 #include "FluxMaxCustoMin.hpp" // Inclui a definição da nossa classe de solução
+#include "fast-input.hpp"      // Leitor de inteiros compartilhado (mmap / binário)
 
 using namespace std;
 
@@ -24,8 +25,10 @@ int main()
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
 
-    int n_vertices, n_arestas;
-    cin >> n_vertices >> n_arestas;
+    // A entrada é lida pelo FastInput (texto ou formato binário), sem passar pelo cin.
+    FastInput entrada;
+    int n_vertices = entrada.nextInt();
+    int n_arestas = entrada.nextInt();
 
     Grafo grafo(n_vertices);
     vector<ArestaOriginal> arestas_originais;
@@ -34,8 +37,10 @@ int main()
     // Loop para ler todas as arestas da entrada.
     for (int i = 0; i < n_arestas; ++i)
     {
-        int de, para, cap, custo;
-        cin >> de >> para >> cap >> custo;
+        int de = entrada.nextInt();
+        int para = entrada.nextInt();
+        int cap = entrada.nextInt();
+        int custo = entrada.nextInt();
         grafo.adicionar_aresta(de, para, cap, custo);
         arestas_originais.push_back({de, para, cap, custo});
     }
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "indexed-heap.hpp"
+
+using namespace std;
+
+// Políticas de fila de prioridade para o Dijkstra, escolhidas em tempo de
+// compilação por parâmetro de template. Todas têm a mesma interface:
+//
+//   reset(maxStep)     prepara uma nova busca; maxStep é o maior peso de aresta
+//   push(key, value)   insere value com prioridade key
+//   pop()              remove e retorna o par (key, value) de menor chave
+//   empty()
+//
+// Nas filas preguiçosas o Dijkstra reinsere o vértice quando a distância
+// melhora e descarta entradas desatualizadas ao retirá-las; em
+// IndexedHeapQueue o push diminui a chave e o vértice aparece uma só vez.
+// RadixHeap e DialQueue são filas monotônicas: exigem pesos não negativos
+// (toda chave inserida é >= à última chave retirada).
+
+// Heap binário da biblioteca padrão: O(log m) por operação, sem restrições
+class BinaryHeapQueue {
+    public:
+
+    static const bool needsMaxStep = false;
+
+    void reset(unsigned int) {}
+    bool empty() const { return heap.empty(); }
+    void push(unsigned int key, int value) { heap.push({key, value}); }
+
+    pair<unsigned int, int> pop() {
+        pair<unsigned int, int> top = heap.top();
+        heap.pop();
+        return top;
+    }
+
+    private:
+
+    priority_queue<pair<unsigned int, int>, vector<pair<unsigned int, int>>,
+                   greater<pair<unsigned int, int>>> heap;
+};
+
+// Radix heap: o balde i guarda chaves cujo bit mais alto diferente de last é o
+// i-ésimo; cada elemento desce de balde no máximo 32 vezes, o que dá
+// O(m + n log C) no Dijkstra
+class RadixHeap {
+    public:
+
+    static const bool needsMaxStep = false;
+
+    RadixHeap() : last(0), count(0) {}
+
+    void reset(unsigned int) {
+        if (count > 0) {
+            for (auto& bucket : buckets) bucket.clear();
+        }
+        last = 0;
+        count = 0;
+    }
+
+    bool empty() const { return count == 0; }
+
+    void push(unsigned int key, int value) {
+        buckets[bucketOf(key)].push_back({key, value});
+        count++;
+    }
+
+    pair<unsigned int, int> pop() {
+        if (buckets[0].empty()) {
+            // Redistribui o primeiro balde não vazio a partir da sua menor chave
+            int i = 1;
+            while (buckets[i].empty()) i++;
+
+            unsigned int smallest = buckets[i][0].first;
+            for (const auto& entry : buckets[i]) {
+                if (entry.first < smallest) smallest = entry.first;
+            }
+            last = smallest;
+
+            for (const auto& entry : buckets[i]) {
+                buckets[bucketOf(entry.first)].push_back(entry);
+            }
+            buckets[i].clear();
+        }
+
+        pair<unsigned int, int> top = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return top;
+    }
+
+    private:
+
+    vector<pair<unsigned int, int>> buckets[33];
+    unsigned int last;      // Última chave retirada
+    int count;
+
+    int bucketOf(unsigned int key) const {
+        return key == last ? 0 : 32 - __builtin_clz(key ^ last);
+    }
+};
+
+// Fila de Dial: maxStep + 1 baldes circulares indexados pela chave; como todas
+// as chaves pendentes estão em [atual, atual + maxStep], cada balde guarda uma
+// única chave. O(m + D) no Dijkstra, sendo D a maior distância: boa para pesos
+// pequenos, inviável se maxStep for muito grande.
+class DialQueue {
+    public:
+
+    static const bool needsMaxStep = true;
+
+    DialQueue() : current(0), count(0) {}
+
+    void reset(unsigned int maxStep) {
+        if (buckets.size() != (size_t)maxStep + 1) {
+            buckets.assign((size_t)maxStep + 1, vector<int>());
+        } else if (count > 0) {
+            for (auto& bucket : buckets) bucket.clear();
+        }
+        current = 0;
+        count = 0;
+    }
+
+    bool empty() const { return count == 0; }
+
+    void push(unsigned int key, int value) {
+        buckets[key % buckets.size()].push_back(value);
+        count++;
+    }
+
+    pair<unsigned int, int> pop() {
+        size_t slot = current % buckets.size();
+        while (buckets[slot].empty()) {
+            current++;
+            if (++slot == buckets.size()) slot = 0;
+        }
+
+        int value = buckets[slot].back();
+        buckets[slot].pop_back();
+        count--;
+        return {current, value};
+    }
+
+    private:
+
+    vector<vector<int>> buckets;
+    unsigned int current;   // Menor chave possível entre as pendentes
+    int count;
+};
+
+// Heap 4-ário indexado com decreaseKey: no máximo n entradas, O(log n) por
+// operação e sem exigir chaves monotônicas
+typedef IndexedDaryHeap<4> IndexedHeapQueue;
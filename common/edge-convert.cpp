@@ -0,0 +1,69 @@
+// Conversor de instâncias textuais para o formato binário do FastInput
+// Uso: edge-convert <entrada.in> <saida.bin>
+//
+// A saída contém a assinatura FAST_INPUT_MAGIC seguida de todos os inteiros
+// da entrada como int32, na mesma ordem; os executáveis dos laboratórios
+// reconhecem o formato automaticamente ao ler o arquivo.
+
+#include <cstdio>
+#include <iostream>
+#include <vector>
+#include "fast-input.hpp"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        cerr << "Uso: " << argv[0] << " <entrada.in> <saida.bin>" << endl;
+        return 1;
+    }
+
+    FastInput input{string(argv[1])};
+    if (!input.good()) {
+        cerr << "Erro: Não foi possível abrir o arquivo " << argv[1] << endl;
+        return 1;
+    }
+
+    FILE* output = fopen(argv[2], "wb");
+    if (!output) {
+        cerr << "Erro: Não foi possível criar o arquivo " << argv[2] << endl;
+        return 1;
+    }
+
+    // Grava em blocos para reduzir o número de chamadas de sistema
+    const size_t chunk = 1 << 18;
+    vector<int> values;
+    values.reserve(chunk);
+    bool ok = fwrite(FAST_INPUT_MAGIC, 1, 4, output) == 4;
+
+    // Um token inválido interrompe a conversão com erro, sem gravar um
+    // arquivo com parte da instância
+    int value;
+    size_t total = 0;
+    while (ok && input.nextInt(value)) {
+        values.push_back(value);
+        if (values.size() == chunk) {
+            ok = fwrite(values.data(), sizeof(int), values.size(), output) == values.size();
+            total += values.size();
+            values.clear();
+        }
+    }
+    if (ok && !values.empty()) {
+        ok = fwrite(values.data(), sizeof(int), values.size(), output) == values.size();
+        total += values.size();
+    }
+
+    if (fclose(output) != 0 || !ok) {
+        cerr << "Erro: Falha ao gravar " << argv[2] << endl;
+        remove(argv[2]);
+        return 1;
+    }
+    if (input.failed()) {
+        cerr << "Erro: Token inválido em " << argv[1] << " (byte " << input.offset() << ")" << endl;
+        remove(argv[2]);
+        return 1;
+    }
+
+    cerr << total << " inteiros convertidos" << endl;
+    return 0;
+}
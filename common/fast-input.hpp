@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Assinatura do formato binário: após ela vêm apenas inteiros int32
+// (ordem de bytes nativa), na mesma sequência da entrada textual
+static const char FAST_INPUT_MAGIC[4] = {'G', 'B', 'I', 'N'};
+
+// Leitor de inteiros compartilhado pelos executáveis dos laboratórios.
+// Arquivos regulares (inclusive a entrada padrão redirecionada) são mapeados
+// com mmap e percorridos sem cópia; pipes são lidos em blocos para um buffer.
+// O texto é convertido por um scanner próprio, sem locale nem sincronização
+// com stdio; no formato binário cada inteiro é copiado diretamente.
+// Um token que não é inteiro interrompe a leitura e é sinalizado por failed(),
+// para que o chamador relate o erro em vez de seguir com uma entrada menor.
+class FastInput {
+    public:
+
+    // Lê da entrada padrão
+    FastInput() : fd(-1), mapped(nullptr), mappedSize(0), opened(true), invalid(false) {
+        load(STDIN_FILENO);
+    }
+
+    // Lê de um arquivo (good() indica se foi possível abri-lo)
+    explicit FastInput(const string& path)
+        : fd(-1), mapped(nullptr), mappedSize(0), opened(false), invalid(false) {
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            begin = end = cur = nullptr;
+            binary = false;
+            return;
+        }
+        opened = true;
+        load(fd);
+    }
+
+    ~FastInput() {
+        if (mapped) munmap(mapped, mappedSize);
+        if (fd >= 0) close(fd);
+    }
+
+    FastInput(const FastInput&) = delete;
+    FastInput& operator=(const FastInput&) = delete;
+
+    bool good() const { return opened; }
+    bool isBinary() const { return binary; }
+
+    // Verdadeiro se a leitura parou em um token inválido (e não no fim da entrada)
+    bool failed() const { return invalid; }
+
+    // Posição atual, em bytes desde o início da entrada
+    size_t offset() const { return (size_t)(cur - begin); }
+
+    // Lê o próximo inteiro; retorna false no fim da entrada ou em um token
+    // inválido (failed() distingue os dois casos)
+    bool nextInt(int& value) {
+        if (invalid) return false;
+        if (binary) {
+            if (end - cur < 4) return false;
+            memcpy(&value, cur, 4);
+            cur += 4;
+            return true;
+        }
+
+        while (cur < end && isSpace(*cur)) cur++;
+        if (cur == end) return false;
+
+        bool negative = false;
+        if (*cur == '-' || *cur == '+') {
+            negative = (*cur == '-');
+            cur++;
+        }
+        if (cur == end || !isDigit(*cur)) {
+            invalid = true;
+            return false;
+        }
+
+        // Acumula em unsigned para que INT_MIN não estoure
+        unsigned int x = 0;
+        while (cur < end && isDigit(*cur)) {
+            x = x * 10 + (unsigned int)(*cur - '0');
+            cur++;
+        }
+        value = negative ? (int)(0u - x) : (int)x;
+        return true;
+    }
+
+    // Versão de conveniência: retorna 0 quando não há mais inteiros (como cin)
+    int nextInt() {
+        int value = 0;
+        nextInt(value);
+        return value;
+    }
+
+    // Lê os inteiros até o fim da linha atual; retorna false se a entrada acabou
+    // ou se a linha tem um token inválido (failed() fica verdadeiro).
+    // No formato binário não há linhas: todos os inteiros restantes são lidos.
+    bool nextLine(vector<int>& values) {
+        values.clear();
+        if (invalid || cur == end) return false;
+
+        if (binary) {
+            int value;
+            while (nextInt(value)) values.push_back(value);
+            return true;
+        }
+
+        while (cur < end && *cur != '\n') {
+            if (isSpace(*cur)) {
+                cur++;
+                continue;
+            }
+            int value;
+            if (!nextInt(value)) return false;
+            values.push_back(value);
+        }
+        if (cur < end) cur++; // Consome o '\n'
+        return true;
+    }
+
+    private:
+
+    int fd;                 // Descritor aberto por esta instância (-1 para stdin)
+    void* mapped;           // Região mapeada (nullptr se o conteúdo está em buffer)
+    size_t mappedSize;
+    vector<char> buffer;    // Conteúdo lido de pipes
+    bool opened;
+    bool invalid;           // Parou em um token inválido
+    bool binary;
+    const char* begin;
+    const char* end;
+    const char* cur;
+
+    static bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    // Mapeia o arquivo inteiro ou, se não for possível, lê tudo para o buffer
+    void load(int source) {
+        struct stat info;
+        if (fstat(source, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            mappedSize = (size_t)info.st_size;
+            mapped = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, source, 0);
+            if (mapped == MAP_FAILED) {
+                mapped = nullptr;
+            } else {
+#ifdef MADV_SEQUENTIAL
+                madvise(mapped, mappedSize, MADV_SEQUENTIAL);
+#endif
+                begin = (const char*)mapped;
+                end = begin + mappedSize;
+            }
+        }
+
+        if (!mapped) {
+            const size_t chunk = 1 << 20;
+            size_t used = 0;
+            for (;;) {
+                buffer.resize(used + chunk);
+                ssize_t got = read(source, buffer.data() + used, chunk);
+                if (got <= 0) break;
+                used += (size_t)got;
+            }
+            buffer.resize(used);
+            begin = buffer.data();
+            end = begin + used;
+        }
+
+        cur = begin;
+        binary = (end - begin >= 4 && memcmp(begin, FAST_INPUT_MAGIC, 4) == 0);
+        if (binary) cur += 4;
+    }
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Heap D-ário indexado por valor (0 <= valor < capacidade), com decreaseKey real.
+// A posição de cada valor no heap fica em um vetor auxiliar, então cada valor
+// aparece no máximo uma vez e o heap nunca passa de n elementos. Com D = 4 a
+// altura cai pela metade em relação ao heap binário e os filhos de um nó
+// ficam na mesma linha de cache.
+//
+// Também segue a interface das políticas de dijkstra-queues.hpp: push insere
+// o valor ou diminui a sua chave, de modo que não há entradas desatualizadas.
+template <int D = 4, typename Key = unsigned int>
+class IndexedDaryHeap {
+    public:
+
+    static const bool needsMaxStep = false;
+
+    // Esvazia o heap (o vetor de posições cresce sob demanda nos push)
+    void reset(unsigned int = 0) {
+        for (const auto& entry : heap) position[entry.second] = -1;
+        heap.clear();
+    }
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+
+    bool contains(int value) const {
+        return value < (int)position.size() && position[value] >= 0;
+    }
+
+    // Insere value com prioridade key ou, se já presente, diminui a sua chave
+    // (uma chave maior que a atual é ignorada)
+    void push(Key key, int value) {
+        if (value >= (int)position.size()) position.resize(value + 1, -1);
+
+        if (position[value] >= 0) {
+            decreaseKey(value, key);
+            return;
+        }
+        heap.push_back({key, value});
+        position[value] = (int)heap.size() - 1;
+        siftUp((int)heap.size() - 1);
+    }
+
+    void decreaseKey(int value, Key key) {
+        int i = position[value];
+        if (!(key < heap[i].first)) return;
+        heap[i].first = key;
+        siftUp(i);
+    }
+
+    const pair<Key, int>& top() const { return heap[0]; }
+
+    // Remove e retorna o par (chave, valor) de menor chave
+    pair<Key, int> pop() {
+        pair<Key, int> smallest = heap[0];
+        position[smallest.second] = -1;
+
+        pair<Key, int> last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            position[last.second] = 0;
+            siftDown(0);
+        }
+        return smallest;
+    }
+
+    private:
+
+    vector<pair<Key, int>> heap;    // (chave, valor)
+    vector<int> position;           // Índice de cada valor em heap (-1 se ausente)
+
+    // Sobe o elemento i deslocando os pais (uma única escrita por nível)
+    void siftUp(int i) {
+        pair<Key, int> entry = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (!(entry.first < heap[parent].first)) break;
+            heap[i] = heap[parent];
+            position[heap[i].second] = i;
+            i = parent;
+        }
+        heap[i] = entry;
+        position[entry.second] = i;
+    }
+
+    // Desce o elemento i trocando-o pelo menor dos até D filhos
+    void siftDown(int i) {
+        pair<Key, int> entry = heap[i];
+        int n = (int)heap.size();
+        for (;;) {
+            int first = D * i + 1;
+            if (first >= n) break;
+
+            int best = first;
+            int end = first + D < n ? first + D : n;
+            for (int c = first + 1; c < end; c++) {
+                if (heap[c].first < heap[best].first) best = c;
+            }
+            if (!(heap[best].first < entry.first)) break;
+
+            heap[i] = heap[best];
+            position[heap[i].second] = i;
+            i = best;
+        }
+        heap[i] = entry;
+        position[entry.second] = i;
+    }
+};